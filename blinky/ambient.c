@@ -0,0 +1,130 @@
+#include <nrfx_saadc.h>
+#include <nrfx_ppi.h>
+#include <nrf_rtc.h>
+#include <app_error.h>
+#include "ambient.h"
+#include "brightness.h"
+#include "irq_priority.h"
+#include "tickless.h"
+#include "bottom_half.h"
+
+#if AMBIENT_ENABLED
+
+#define AMBIENT_RTC NRF_RTC1
+#define SAMPLE_PERIOD_TICKS (32768UL / AMBIENT_CONFIG_SAMPLE_HZ)
+// 12-bit single ended
+#define RAW_MAX 4095
+
+static nrf_saadc_value_t buffers[2][AMBIENT_CONFIG_BUFFER_SIZE];
+
+// IIR state, scaled up by AMBIENT_CONFIG_FILTER_SHIFT bits to keep the fraction
+static int32_t filter_acc;
+static bool filter_valid = false;
+
+static ambient_stats_t stats;
+
+static int16_t filter_update(int16_t raw)
+{
+    if (!filter_valid)
+    {
+        filter_acc = (int32_t)raw << AMBIENT_CONFIG_FILTER_SHIFT;
+        filter_valid = true;
+    }
+    else
+    {
+        filter_acc += raw - (filter_acc >> AMBIENT_CONFIG_FILTER_SHIFT);
+    }
+    return (int16_t)(filter_acc >> AMBIENT_CONFIG_FILTER_SHIFT);
+}
+
+// Linear from AMBIENT_CONFIG_MIN_PERMILLE in the dark to full scale
+static uint16_t level_from_raw(int16_t raw)
+{
+    // single ended input can read slightly below zero
+    if (raw < 0)
+        raw = 0;
+
+    return AMBIENT_CONFIG_MIN_PERMILLE +
+           (uint16_t)(((uint32_t)(BRIGHTNESS_MAX - AMBIENT_CONFIG_MIN_PERMILLE) * raw) / RAW_MAX);
+}
+
+static void saadc_handler(nrfx_saadc_evt_t const *p_event)
+{
+    int32_t sum = 0;
+
+    if (p_event->type != NRFX_SAADC_EVT_DONE)
+        return;
+
+    TOP_HALF_BEGIN();
+
+    // requeue first so the next tick already has somewhere to go
+    APP_ERROR_CHECK(nrfx_saadc_buffer_convert(p_event->data.done.p_buffer, AMBIENT_CONFIG_BUFFER_SIZE));
+
+    for (uint32_t i = 0; i < p_event->data.done.size; i++)
+        sum += p_event->data.done.p_buffer[i];
+
+    stats.buffers++;
+    stats.last_raw = (int16_t)(sum / p_event->data.done.size);
+    stats.filtered = filter_update(stats.last_raw);
+
+    brightness_ambient_set(level_from_raw(stats.filtered));
+    tickless_notify();
+
+    TOP_HALF_END();
+}
+
+void ambient_init(void)
+{
+    nrf_ppi_channel_t channel;
+    nrfx_saadc_config_t config = {
+        .resolution = NRF_SAADC_RESOLUTION_12BIT,
+        .oversample = (nrf_saadc_oversample_t)AMBIENT_CONFIG_OVERSAMPLE,
+        .interrupt_priority = IRQ_PRIORITY_LOW,
+        // sampling is started by PPI, not by nrfx_saadc_sample()
+        .low_power_mode = false};
+    nrf_saadc_channel_config_t channel_config = {
+        .resistor_p = NRF_SAADC_RESISTOR_DISABLED,
+        .resistor_n = NRF_SAADC_RESISTOR_DISABLED,
+        .gain = NRF_SAADC_GAIN1_6,
+        .reference = NRF_SAADC_REFERENCE_INTERNAL,
+        // high impedance divider
+        .acq_time = NRF_SAADC_ACQTIME_40US,
+        .mode = NRF_SAADC_MODE_SINGLE_ENDED,
+        // all oversampled conversions on one SAMPLE task
+        .burst = NRF_SAADC_BURST_ENABLED,
+        .pin_p = NRF_SAADC_INPUT_AIN0,
+        .pin_n = NRF_SAADC_INPUT_DISABLED};
+
+    APP_ERROR_CHECK(nrfx_saadc_init(&config, saadc_handler));
+    APP_ERROR_CHECK(nrfx_saadc_channel_init(0, &channel_config));
+
+    // double buffering: the second buffer is queued behind the first
+    APP_ERROR_CHECK(nrfx_saadc_buffer_convert(buffers[0], AMBIENT_CONFIG_BUFFER_SIZE));
+    APP_ERROR_CHECK(nrfx_saadc_buffer_convert(buffers[1], AMBIENT_CONFIG_BUFFER_SIZE));
+
+    // Periodic compare instead of TICK, which would keep PCLK16M running:
+    // COMPARE0 samples and clears the counter through PPI. No RTC1 interrupt.
+    nrf_rtc_task_trigger(AMBIENT_RTC, NRF_RTC_TASK_STOP);
+    nrf_rtc_task_trigger(AMBIENT_RTC, NRF_RTC_TASK_CLEAR);
+    nrf_rtc_prescaler_set(AMBIENT_RTC, 0);
+    nrf_rtc_cc_set(AMBIENT_RTC, 0, SAMPLE_PERIOD_TICKS);
+    nrf_rtc_event_clear(AMBIENT_RTC, NRF_RTC_EVENT_COMPARE_0);
+    nrf_rtc_event_enable(AMBIENT_RTC, NRF_RTC_INT_COMPARE0_MASK);
+
+    APP_ERROR_CHECK(nrfx_ppi_channel_alloc(&channel));
+    APP_ERROR_CHECK(nrfx_ppi_channel_assign(channel,
+                                            nrf_rtc_event_address_get(AMBIENT_RTC, NRF_RTC_EVENT_COMPARE_0),
+                                            nrfx_saadc_sample_task_get()));
+    APP_ERROR_CHECK(nrfx_ppi_channel_fork_assign(channel,
+                                                 nrf_rtc_task_address_get(AMBIENT_RTC, NRF_RTC_TASK_CLEAR)));
+    APP_ERROR_CHECK(nrfx_ppi_channel_enable(channel));
+
+    nrf_rtc_task_trigger(AMBIENT_RTC, NRF_RTC_TASK_START);
+}
+
+void ambient_stats_get(ambient_stats_t *p_stats)
+{
+    *p_stats = stats;
+}
+
+#endif // AMBIENT_ENABLED
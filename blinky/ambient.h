@@ -0,0 +1,26 @@
+#ifndef AMBIENT_H__
+#define AMBIENT_H__
+
+#include <stdint.h>
+
+// Auto-brightness from a light sensor on AIN0 (P0.02).
+//
+// An RTC1 compare triggers the SAADC SAMPLE task over PPI, and every
+// SAMPLE takes one burst of hardware-oversampled conversions, so sampling
+// needs no CPU at all. Results go by EasyDMA into one of two buffers; the
+// CPU only wakes when a buffer is full, hands it straight back to the
+// driver and runs the average through an integer IIR filter before
+// passing it to brightness_ambient_set().
+
+typedef struct
+{
+    uint32_t buffers; // full buffers processed
+    int16_t last_raw; // average of the last buffer
+    int16_t filtered; // IIR output
+} ambient_stats_t;
+
+void ambient_init(void);
+
+void ambient_stats_get(ambient_stats_t *p_stats);
+
+#endif // AMBIENT_H__
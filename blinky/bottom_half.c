@@ -0,0 +1,115 @@
+#include <nrfx.h>
+#include "bottom_half.h"
+#include "irq_priority.h"
+#include "cycles.h"
+#include "trace.h"
+#include "ram_usage.h"
+
+typedef struct
+{
+    bottom_half_fn_t fn;
+    uint32_t arg0;
+    uint32_t arg1;
+    uint32_t posted_at;
+} work_t;
+
+static work_t queue[BOTTOM_HALF_CONFIG_QUEUE_SIZE];
+static volatile uint32_t head = 0;
+static volatile uint32_t tail = 0;
+
+static bottom_half_stats_t stats;
+
+void bottom_half_init(void)
+{
+    cycles_init();
+
+    NRFX_IRQ_PRIORITY_SET(SWI1_EGU1_IRQn, IRQ_PRIORITY_BOTTOM_HALF);
+    NRFX_IRQ_ENABLE(SWI1_EGU1_IRQn);
+}
+
+bool bottom_half_post(bottom_half_fn_t fn, uint32_t arg0, uint32_t arg1)
+{
+    uint32_t now = cycles_now();
+    bool queued = false;
+
+    // every top half and bottom half chain ends here, deepest on the stack
+    ram_usage_isr_sample();
+
+    NRFX_CRITICAL_SECTION_ENTER();
+    uint32_t depth = head - tail;
+    if (depth < BOTTOM_HALF_CONFIG_QUEUE_SIZE)
+    {
+        work_t *p_work = &queue[head % BOTTOM_HALF_CONFIG_QUEUE_SIZE];
+        p_work->fn = fn;
+        p_work->arg0 = arg0;
+        p_work->arg1 = arg1;
+        p_work->posted_at = now;
+        head++;
+
+        stats.posted++;
+        if (depth + 1 > stats.queue_peak)
+            stats.queue_peak = depth + 1;
+        queued = true;
+    }
+    else
+    {
+        stats.dropped++;
+    }
+    NRFX_CRITICAL_SECTION_EXIT();
+
+    if (queued)
+        NRFX_IRQ_PENDING_SET(SWI1_EGU1_IRQn);
+
+    return queued;
+}
+
+void bottom_half_top_half_record(uint32_t cycles)
+{
+    volatile uint32_t *p_max = &stats.top_half_max_cycles;
+
+    // top halves at different priorities race on the maximum; retry if one
+    // preempted between the load and the store, without masking interrupts
+    do
+    {
+        if (cycles <= __LDREXW(p_max))
+        {
+            __CLREX();
+            return;
+        }
+    } while (__STREXW(cycles, p_max) != 0);
+}
+
+void bottom_half_input_latency_record(uint32_t us)
+{
+    if (us > stats.input_max_us)
+        stats.input_max_us = us;
+}
+
+void bottom_half_stats_get(bottom_half_stats_t *p_stats)
+{
+    NRFX_CRITICAL_SECTION_ENTER();
+    *p_stats = stats;
+    NRFX_CRITICAL_SECTION_EXIT();
+}
+
+void SWI1_EGU1_IRQHandler(void)
+{
+    while (tail != head)
+    {
+        work_t work = queue[tail % BOTTOM_HALF_CONFIG_QUEUE_SIZE];
+        uint32_t start = cycles_now();
+
+        if (start - work.posted_at > stats.dispatch_max_cycles)
+            stats.dispatch_max_cycles = start - work.posted_at;
+
+        TRACE_BEGIN(TRACE_ID_BOTTOM_HALF, (uint32_t)(uintptr_t)work.fn, work.arg0);
+        work.fn(work.arg0, work.arg1);
+        TRACE_END(TRACE_ID_BOTTOM_HALF);
+
+        uint32_t elapsed = cycles_now() - start;
+        if (elapsed > stats.work_max_cycles)
+            stats.work_max_cycles = elapsed;
+
+        tail++;
+    }
+}
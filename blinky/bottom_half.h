@@ -0,0 +1,42 @@
+#ifndef BOTTOM_HALF_H__
+#define BOTTOM_HALF_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "cycles.h"
+
+// Deferred interrupt work. Top halves post a function with two words of
+// captured state; the queue is drained from the SWI1_EGU1 interrupt at
+// IRQ_PRIORITY_BOTTOM_HALF, in posting order. See irq_priority.h.
+
+typedef void (*bottom_half_fn_t)(uint32_t arg0, uint32_t arg1);
+
+typedef struct
+{
+    uint32_t posted;              // work items queued
+    uint32_t dropped;             // posts refused because the queue was full
+    uint32_t queue_peak;          // deepest the queue has been
+    uint32_t top_half_max_cycles; // longest top half reported
+    uint32_t work_max_cycles;     // longest single bottom half item
+    uint32_t dispatch_max_cycles; // post to start of the item
+    uint32_t input_max_us;        // hardware edge to top half entry
+} bottom_half_stats_t;
+
+void bottom_half_init(void);
+
+// Safe from any interrupt priority and from thread mode
+bool bottom_half_post(bottom_half_fn_t fn, uint32_t arg0, uint32_t arg1);
+
+// Called by every top half with its run time, and by input top halves
+// with their latency when the edge time is known
+void bottom_half_top_half_record(uint32_t cycles);
+void bottom_half_input_latency_record(uint32_t us);
+
+// Bracket a top half's work to record its run time; an early return
+// before TOP_HALF_END() is not recorded
+#define TOP_HALF_BEGIN() uint32_t top_half_start = cycles_now()
+#define TOP_HALF_END() bottom_half_top_half_record(cycles_now() - top_half_start)
+
+void bottom_half_stats_get(bottom_half_stats_t *p_stats);
+
+#endif // BOTTOM_HALF_H__
@@ -0,0 +1,76 @@
+#include <nrfx.h>
+#include <sdk_config.h>
+#include "brightness.h"
+
+static volatile uint16_t level = BRIGHTNESS_MAX;
+static volatile uint16_t ambient = BRIGHTNESS_MAX;
+static volatile bool ramping = false;
+static volatile int8_t ramp_direction = 1;
+
+uint16_t brightness_get(void)
+{
+    return level;
+}
+
+static uint16_t clamp(int32_t new_level)
+{
+    if (new_level > BRIGHTNESS_MAX)
+        return BRIGHTNESS_MAX;
+    if (new_level < BRIGHTNESS_CONFIG_MIN)
+        return BRIGHTNESS_CONFIG_MIN;
+    return (uint16_t)new_level;
+}
+
+void brightness_set(uint16_t new_level)
+{
+    level = clamp(new_level);
+}
+
+void brightness_adjust(int32_t delta)
+{
+    NRFX_CRITICAL_SECTION_ENTER();
+    level = clamp((int32_t)level + delta);
+    NRFX_CRITICAL_SECTION_EXIT();
+}
+
+void brightness_ambient_set(uint16_t new_ambient)
+{
+    ambient = (new_ambient > BRIGHTNESS_MAX) ? BRIGHTNESS_MAX : new_ambient;
+}
+
+uint16_t brightness_apply(uint16_t duty)
+{
+    // at most 1000 * 1000 * 1000, fits
+    return (uint16_t)(((uint32_t)duty * level * ambient) / (BRIGHTNESS_MAX * BRIGHTNESS_MAX));
+}
+
+void brightness_ramp_start(void)
+{
+    int8_t direction = -ramp_direction;
+
+    // already at that end, go the other way
+    if ((direction > 0 && level >= BRIGHTNESS_MAX) ||
+        (direction < 0 && level <= BRIGHTNESS_CONFIG_MIN))
+        direction = -direction;
+
+    ramp_direction = direction;
+    ramping = true;
+}
+
+void brightness_ramp_stop(void)
+{
+    ramping = false;
+}
+
+bool brightness_ramping(void)
+{
+    return ramping;
+}
+
+void brightness_ramp_step(void)
+{
+    if (!ramping)
+        return;
+
+    brightness_adjust(ramp_direction * BRIGHTNESS_CONFIG_RAMP_STEP);
+}
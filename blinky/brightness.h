@@ -0,0 +1,37 @@
+#ifndef BRIGHTNESS_H__
+#define BRIGHTNESS_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Global LED brightness in permille, applied as a scale factor to every
+// duty written through pwm_set_duty(). The user level is further scaled
+// by the ambient factor from the light sensor, if there is one.
+
+#define BRIGHTNESS_MAX 1000
+
+uint16_t brightness_get(void);
+
+void brightness_set(uint16_t level);
+
+// Moves the level by delta permille, clamped. Safe from interrupt context.
+void brightness_adjust(int32_t delta);
+
+// Ambient light factor in permille. Safe from interrupt context.
+void brightness_ambient_set(uint16_t ambient);
+
+// Scales a duty by the current brightness
+uint16_t brightness_apply(uint16_t duty);
+
+// Starts ramping; the direction alternates with every ramp. Safe from
+// interrupt context.
+void brightness_ramp_start(void);
+
+void brightness_ramp_stop(void);
+
+bool brightness_ramping(void);
+
+// Moves an active ramp one step, called once per frame
+void brightness_ramp_step(void);
+
+#endif // BRIGHTNESS_H__
@@ -142,7 +142,7 @@
 // <e> NRF_LOG_ENABLED - nrf_log - Logger
 //==========================================================
 #ifndef NRF_LOG_ENABLED
-#define NRF_LOG_ENABLED 0
+#define NRF_LOG_ENABLED 1
 #endif
 // <h> Log message pool - Configuration of log message pool
 
@@ -193,7 +193,7 @@
 // <16384=> 16384
 
 #ifndef NRF_LOG_BUFSIZE
-#define NRF_LOG_BUFSIZE 1024
+#define NRF_LOG_BUFSIZE 4096
 #endif
 
 // <q> NRF_LOG_CLI_CMDS  - Enable CLI commands for the module.
@@ -326,15 +326,53 @@
 // <i> Function for getting the timestamp is provided by the user
 //==========================================================
 #ifndef NRF_LOG_USES_TIMESTAMP
-#define NRF_LOG_USES_TIMESTAMP 0
+#define NRF_LOG_USES_TIMESTAMP 1
 #endif
 // <o> NRF_LOG_TIMESTAMP_DEFAULT_FREQUENCY - Default frequency of the timestamp (in Hz) or 0 to use app_timer frequency.
 #ifndef NRF_LOG_TIMESTAMP_DEFAULT_FREQUENCY
-#define NRF_LOG_TIMESTAMP_DEFAULT_FREQUENCY 0
+#define NRF_LOG_TIMESTAMP_DEFAULT_FREQUENCY 32768
 #endif
 
 // </e>
 
+// <h> nrf_log_backend_rtt - Log RTT backend
+
+//==========================================================
+// <q> NRF_LOG_BACKEND_RTT_ENABLED  - Log RTT backend
+
+#ifndef NRF_LOG_BACKEND_RTT_ENABLED
+#define NRF_LOG_BACKEND_RTT_ENABLED 1
+#endif
+
+// <o> NRF_LOG_BACKEND_RTT_TEMP_BUFFER_SIZE - Size of buffer for partially processed strings.
+// <i> Size of the buffer is a trade-off between RAM usage and processing.
+// <i> if buffer is smaller then strings will often be fragmented.
+// <i> It is recommended to use size which will fit typical log and only the
+// <i> longer one will be fragmented.
+
+#ifndef NRF_LOG_BACKEND_RTT_TEMP_BUFFER_SIZE
+#define NRF_LOG_BACKEND_RTT_TEMP_BUFFER_SIZE 64
+#endif
+
+// <o> NRF_LOG_BACKEND_RTT_TX_RETRY_DELAY_MS - Period before retrying writing to RTT
+#ifndef NRF_LOG_BACKEND_RTT_TX_RETRY_DELAY_MS
+#define NRF_LOG_BACKEND_RTT_TX_RETRY_DELAY_MS 1
+#endif
+
+// <o> NRF_LOG_BACKEND_RTT_TX_RETRY_CNT - Writing to RTT retries.
+// <i> If RTT fails to accept any new data after retries
+// <i> module assumes that host is not active and on next
+// <i> request it will perform only one write attempt.
+// <i> On every successful write, module recovers to default
+// <i> number of retries.
+
+#ifndef NRF_LOG_BACKEND_RTT_TX_RETRY_CNT
+#define NRF_LOG_BACKEND_RTT_TX_RETRY_CNT 3
+#endif
+
+// </h>
+//==========================================================
+
 // <h> nrf_log module configuration
 
 //==========================================================
@@ -3111,7 +3149,7 @@
 // <7=> 7
 
 #ifndef NRFX_PWM_DEFAULT_CONFIG_IRQ_PRIORITY
-#define NRFX_PWM_DEFAULT_CONFIG_IRQ_PRIORITY 7
+#define NRFX_PWM_DEFAULT_CONFIG_IRQ_PRIORITY 5
 #endif
 
 // <e> NRFX_GPIOTE_ENABLED - nrfx_gpiote - GPIOTE peripheral driver
@@ -3121,11 +3159,13 @@
 #endif
 
 // <o> NRFX_GPIOTE_CONFIG_NUM_OF_LOW_POWER_EVENTS - Number of lower power input pins
+// <i> The input bank plus the button in low-power sense mode
 #ifndef NRFX_GPIOTE_CONFIG_NUM_OF_LOW_POWER_EVENTS
-#define NRFX_GPIOTE_CONFIG_NUM_OF_LOW_POWER_EVENTS 1
+#define NRFX_GPIOTE_CONFIG_NUM_OF_LOW_POWER_EVENTS 17
 #endif
 
 // <o> NRFX_GPIOTE_CONFIG_IRQ_PRIORITY  - Interrupt priority
+// <i> Must match IRQ_PRIORITY_INPUT in irq_priority.h
 
 // <0=> 0 (highest)
 // <1=> 1
@@ -3137,7 +3177,7 @@
 // <7=> 7
 
 #ifndef NRFX_GPIOTE_CONFIG_IRQ_PRIORITY
-#define NRFX_GPIOTE_CONFIG_IRQ_PRIORITY 7
+#define NRFX_GPIOTE_CONFIG_IRQ_PRIORITY 2
 #endif
 
 // <q> NRFX_SYSTICK_ENABLED  - nrfx_systick - ARM(R) SysTick driver
@@ -3146,5 +3186,596 @@
 #define NRFX_SYSTICK_ENABLED 1
 #endif
 
+// <q> NRFX_PPI_ENABLED  - nrfx_ppi - PPI peripheral allocator
+
+#ifndef NRFX_PPI_ENABLED
+#define NRFX_PPI_ENABLED 1
+#endif
+
+// <e> NRFX_TIMER_ENABLED - nrfx_timer - TIMER periperal driver
+//==========================================================
+#ifndef NRFX_TIMER_ENABLED
+#define NRFX_TIMER_ENABLED 1
+#endif
+// <q> NRFX_TIMER1_ENABLED  - Enable TIMER1 instance
+
+#ifndef NRFX_TIMER1_ENABLED
+#define NRFX_TIMER1_ENABLED 1
+#endif
+
+// <q> NRFX_TIMER2_ENABLED  - Enable TIMER2 instance
+
+#ifndef NRFX_TIMER2_ENABLED
+#define NRFX_TIMER2_ENABLED 1
+#endif
+
+// <q> NRFX_TIMER3_ENABLED  - Enable TIMER3 instance
+
+#ifndef NRFX_TIMER3_ENABLED
+#define NRFX_TIMER3_ENABLED 1
+#endif
+
+// <q> NRFX_TIMER4_ENABLED  - Enable TIMER4 instance
+
+#ifndef NRFX_TIMER4_ENABLED
+#define NRFX_TIMER4_ENABLED 1
+#endif
+
+// <o> NRFX_TIMER_DEFAULT_CONFIG_IRQ_PRIORITY  - Interrupt priority
+
+// <0=> 0 (highest)
+// <1=> 1
+// <2=> 2
+// <3=> 3
+// <4=> 4
+// <5=> 5
+// <6=> 6
+// <7=> 7
+
+#ifndef NRFX_TIMER_DEFAULT_CONFIG_IRQ_PRIORITY
+#define NRFX_TIMER_DEFAULT_CONFIG_IRQ_PRIORITY 7
+#endif
+
+// </e>
+
+// <q> NRFX_QDEC_ENABLED  - nrfx_qdec - QDEC peripheral driver
+
+#ifndef NRFX_QDEC_ENABLED
+#define NRFX_QDEC_ENABLED 1
+#endif
+
+// <q> NRFX_SAADC_ENABLED  - nrfx_saadc - SAADC peripheral driver
+
+#ifndef NRFX_SAADC_ENABLED
+#define NRFX_SAADC_ENABLED 1
+#endif
+
+// <q> NRFX_TEMP_ENABLED  - nrfx_temp - TEMP peripheral driver
+
+#ifndef NRFX_TEMP_ENABLED
+#define NRFX_TEMP_ENABLED 1
+#endif
+
+// <e> NRFX_WDT_ENABLED - nrfx_wdt - WDT peripheral driver
+//==========================================================
+#ifndef NRFX_WDT_ENABLED
+#define NRFX_WDT_ENABLED 1
+#endif
+// <o> NRFX_WDT_CONFIG_NO_IRQ  - Remove WDT IRQ handling from WDT driver
+
+// <0=> Include WDT IRQ handling
+// <1=> Remove WDT IRQ handling
+
+#ifndef NRFX_WDT_CONFIG_NO_IRQ
+#define NRFX_WDT_CONFIG_NO_IRQ 0
+#endif
+
+// </e>
+
+// <h> nRF_Segger_RTT
+
+//==========================================================
+// <h> segger_rtt - SEGGER RTT
+
+//==========================================================
+// <o> SEGGER_RTT_CONFIG_BUFFER_SIZE_UP - Size of upstream buffer.
+// <i> Note that either @ref NRF_LOG_BACKEND_RTT_OUTPUT_BUFFER_SIZE
+// <i> or this value is actually used. It depends on which one is bigger.
+
+#ifndef SEGGER_RTT_CONFIG_BUFFER_SIZE_UP
+#define SEGGER_RTT_CONFIG_BUFFER_SIZE_UP 1024
+#endif
+
+// <o> SEGGER_RTT_CONFIG_MAX_NUM_UP_BUFFERS - Maximum number of upstream buffers.
+#ifndef SEGGER_RTT_CONFIG_MAX_NUM_UP_BUFFERS
+#define SEGGER_RTT_CONFIG_MAX_NUM_UP_BUFFERS 2
+#endif
+
+// <o> SEGGER_RTT_CONFIG_BUFFER_SIZE_DOWN - Size of downstream buffer.
+#ifndef SEGGER_RTT_CONFIG_BUFFER_SIZE_DOWN
+#define SEGGER_RTT_CONFIG_BUFFER_SIZE_DOWN 16
+#endif
+
+// <o> SEGGER_RTT_CONFIG_MAX_NUM_DOWN_BUFFERS - Maximum number of downstream buffers.
+#ifndef SEGGER_RTT_CONFIG_MAX_NUM_DOWN_BUFFERS
+#define SEGGER_RTT_CONFIG_MAX_NUM_DOWN_BUFFERS 2
+#endif
+
+// <o> SEGGER_RTT_CONFIG_DEFAULT_MODE  - RTT behavior if the buffer is full.
+
+// <i> The following modes are supported:
+// <i> - SKIP  - Do not block, output nothing.
+// <i> - TRIM  - Do not block, output as much as fits.
+// <i> - BLOCK - Wait until there is space in the buffer.
+// <0=> SKIP
+// <1=> TRIM
+// <2=> BLOCK_IF_FIFO_FULL
+
+#ifndef SEGGER_RTT_CONFIG_DEFAULT_MODE
+#define SEGGER_RTT_CONFIG_DEFAULT_MODE 0
+#endif
+
+// </h>
+//==========================================================
+
+// </h>
+//==========================================================
+
+// <h> Application
+
+//==========================================================
+// <o> SYSTIME_CONFIG_LFCLK_SRC  - LFCLK source for the RTC2 system time
+
+// <0=> RC
+// <1=> XTAL
+// <2=> Synth
+
+#ifndef SYSTIME_CONFIG_LFCLK_SRC
+#define SYSTIME_CONFIG_LFCLK_SRC 0
+#endif
+
+// <o> BRIGHTNESS_CONFIG_MIN - Lowest global brightness (permille)
+#ifndef BRIGHTNESS_CONFIG_MIN
+#define BRIGHTNESS_CONFIG_MIN 50
+#endif
+
+// <o> BRIGHTNESS_CONFIG_RAMP_STEP - Brightness change per frame while holding (permille)
+#ifndef BRIGHTNESS_CONFIG_RAMP_STEP
+#define BRIGHTNESS_CONFIG_RAMP_STEP 10
+#endif
+
+// <o> BOTTOM_HALF_CONFIG_QUEUE_SIZE - Deferred interrupt work queue length
+
+#ifndef BOTTOM_HALF_CONFIG_QUEUE_SIZE
+#define BOTTOM_HALF_CONFIG_QUEUE_SIZE 16
+#endif
+
+// <e> BUTTON_HW_DEBOUNCE_ENABLED - Debounce the button in hardware (GPIOTE -> PPI -> TIMER3)
+// <i> Edges restart TIMER3 instead of interrupting; the CPU only wakes
+// <i> once the pin has been quiet for BUTTON_HW_DEBOUNCE_QUIET_US.
+// <i> When disabled, every edge interrupts and an adaptive software lockout applies.
+//==========================================================
+#ifndef BUTTON_HW_DEBOUNCE_ENABLED
+#define BUTTON_HW_DEBOUNCE_ENABLED 1
+#endif
+// <o> BUTTON_HW_DEBOUNCE_QUIET_US - Quiet period before an edge is accepted (us)
+#ifndef BUTTON_HW_DEBOUNCE_QUIET_US
+#define BUTTON_HW_DEBOUNCE_QUIET_US 10000
+#endif
+
+// </e>
+
+// <h> Software debounce - used when hardware debounce is off
+//==========================================================
+// <o> DEBOUNCE_CONFIG_FLOOR_US - Shortest lockout, added to the learned bounce
+#ifndef DEBOUNCE_CONFIG_FLOOR_US
+#define DEBOUNCE_CONFIG_FLOOR_US 2000
+#endif
+
+// <o> DEBOUNCE_CONFIG_CEILING_US - Longest lockout, also the startup value
+#ifndef DEBOUNCE_CONFIG_CEILING_US
+#define DEBOUNCE_CONFIG_CEILING_US 70000
+#endif
+
+// </h>
+
+// <q> BUTTON_LOW_POWER_SENSE_ENABLED - Use the PORT event instead of a GPIOTE IN channel for the button
+// <i> Saves the continuous current of a high-accuracy IN channel at the
+// <i> cost of some wakeup latency. Needs BUTTON_HW_DEBOUNCE_ENABLED and
+// <i> EDGE_CAPTURE_ENABLED off, as there is no IN event to route over PPI.
+
+#ifndef BUTTON_LOW_POWER_SENSE_ENABLED
+#define BUTTON_LOW_POWER_SENSE_ENABLED 0
+#endif
+
+// <e> ENCODER_ENABLED - Rotary encoder on QDEC for brightness and speed
+// <i> Only the panel variant has the encoder; while enabled the QDEC
+// <i> samples continuously and keeps HFCLK running.
+//==========================================================
+#ifndef ENCODER_ENABLED
+#define ENCODER_ENABLED 0
+#endif
+// <o> ENCODER_CONFIG_SAMPLEPER  - QDEC sample period
+
+// <0=> 128 us
+// <1=> 256 us
+// <2=> 512 us
+// <3=> 1024 us
+
+#ifndef ENCODER_CONFIG_SAMPLEPER
+#define ENCODER_CONFIG_SAMPLEPER 0
+#endif
+
+// <o> ENCODER_CONFIG_REPORTPER  - Samples per report, i.e. per interrupt at most
+
+// <0=> 10
+// <1=> 40
+// <2=> 80
+// <3=> 120
+// <4=> 160
+// <5=> 200
+// <6=> 240
+// <7=> 280
+
+#ifndef ENCODER_CONFIG_REPORTPER
+#define ENCODER_CONFIG_REPORTPER 1
+#endif
+
+// <o> ENCODER_CONFIG_STEPS_PER_DETENT - Quadrature steps per detent
+#ifndef ENCODER_CONFIG_STEPS_PER_DETENT
+#define ENCODER_CONFIG_STEPS_PER_DETENT 4
+#endif
+
+// <o> ENCODER_CONFIG_BRIGHTNESS_STEP - Brightness change per detent (permille)
+#ifndef ENCODER_CONFIG_BRIGHTNESS_STEP
+#define ENCODER_CONFIG_BRIGHTNESS_STEP 25
+#endif
+
+// </e>
+
+// <e> AMBIENT_ENABLED - Auto-brightness from a light sensor on AIN0 (P0.02)
+// <i> Needs a light sensor fitted on AIN0; the pin floats on a stock dongle.
+//==========================================================
+#ifndef AMBIENT_ENABLED
+#define AMBIENT_ENABLED 0
+#endif
+// <o> AMBIENT_CONFIG_SAMPLE_HZ - Light sensor sample rate
+#ifndef AMBIENT_CONFIG_SAMPLE_HZ
+#define AMBIENT_CONFIG_SAMPLE_HZ 8
+#endif
+
+// <o> AMBIENT_CONFIG_BUFFER_SIZE - Samples per buffer, i.e. per interrupt
+#ifndef AMBIENT_CONFIG_BUFFER_SIZE
+#define AMBIENT_CONFIG_BUFFER_SIZE 8
+#endif
+
+// <o> AMBIENT_CONFIG_OVERSAMPLE  - Hardware oversampling per sample
+
+// <0=> Disabled
+// <1=> 2x
+// <2=> 4x
+// <3=> 8x
+// <4=> 16x
+
+#ifndef AMBIENT_CONFIG_OVERSAMPLE
+#define AMBIENT_CONFIG_OVERSAMPLE 3
+#endif
+
+// <o> AMBIENT_CONFIG_FILTER_SHIFT - IIR filter, new buffer weighs 1/2^shift
+#ifndef AMBIENT_CONFIG_FILTER_SHIFT
+#define AMBIENT_CONFIG_FILTER_SHIFT 3
+#endif
+
+// <o> AMBIENT_CONFIG_MIN_PERMILLE - Brightness factor in the dark
+#ifndef AMBIENT_CONFIG_MIN_PERMILLE
+#define AMBIENT_CONFIG_MIN_PERMILLE 200
+#endif
+
+// </e>
+
+// <e> THERMAL_ENABLED - Derate LED duty by die temperature
+//==========================================================
+#ifndef THERMAL_ENABLED
+#define THERMAL_ENABLED 1
+#endif
+// <o> THERMAL_CONFIG_PERIOD_MS - Time between measurements
+#ifndef THERMAL_CONFIG_PERIOD_MS
+#define THERMAL_CONFIG_PERIOD_MS 2000
+#endif
+
+// <o> THERMAL_CONFIG_DERATE_START_C - Temperature where derating begins
+#ifndef THERMAL_CONFIG_DERATE_START_C
+#define THERMAL_CONFIG_DERATE_START_C 60
+#endif
+
+// <o> THERMAL_CONFIG_DERATE_END_C - Temperature where the minimum is reached
+#ifndef THERMAL_CONFIG_DERATE_END_C
+#define THERMAL_CONFIG_DERATE_END_C 85
+#endif
+
+// <o> THERMAL_CONFIG_MIN_PERMILLE - Duty limit when hottest
+#ifndef THERMAL_CONFIG_MIN_PERMILLE
+#define THERMAL_CONFIG_MIN_PERMILLE 250
+#endif
+
+// </e>
+
+// <e> ENERGY_ENABLED - Estimate energy use from time per power state
+// <i> The currents are a model, measure the board to tune them
+//==========================================================
+#ifndef ENERGY_ENABLED
+#define ENERGY_ENABLED 1
+#endif
+// <o> ENERGY_CONFIG_SLEEP_UA - System ON idle with RTC and RAM retained
+#ifndef ENERGY_CONFIG_SLEEP_UA
+#define ENERGY_CONFIG_SLEEP_UA 3
+#endif
+
+// <o> ENERGY_CONFIG_CPU_UA - CPU running from flash at 64 MHz
+#ifndef ENERGY_CONFIG_CPU_UA
+#define ENERGY_CONFIG_CPU_UA 3300
+#endif
+
+// <o> ENERGY_CONFIG_HFCLK_UA - HF clock and PCLK for timers and PWM
+#ifndef ENERGY_CONFIG_HFCLK_UA
+#define ENERGY_CONFIG_HFCLK_UA 400
+#endif
+
+// <o> ENERGY_CONFIG_PWM_UA - PWM peripheral running
+#ifndef ENERGY_CONFIG_PWM_UA
+#define ENERGY_CONFIG_PWM_UA 200
+#endif
+
+// <o> ENERGY_CONFIG_QDEC_UA - QDEC sampling, without the HF clock
+#ifndef ENERGY_CONFIG_QDEC_UA
+#define ENERGY_CONFIG_QDEC_UA 40
+#endif
+
+// <o> ENERGY_CONFIG_LED_1_UA - LED1 fully on
+#ifndef ENERGY_CONFIG_LED_1_UA
+#define ENERGY_CONFIG_LED_1_UA 4000
+#endif
+
+// <o> ENERGY_CONFIG_LED_R_UA - LED2 red fully on
+#ifndef ENERGY_CONFIG_LED_R_UA
+#define ENERGY_CONFIG_LED_R_UA 5000
+#endif
+
+// <o> ENERGY_CONFIG_LED_G_UA - LED2 green fully on
+#ifndef ENERGY_CONFIG_LED_G_UA
+#define ENERGY_CONFIG_LED_G_UA 2500
+#endif
+
+// <o> ENERGY_CONFIG_LED_B_UA - LED2 blue fully on
+#ifndef ENERGY_CONFIG_LED_B_UA
+#define ENERGY_CONFIG_LED_B_UA 2500
+#endif
+
+// </e>
+
+// <e> WATCHDOG_ENABLED - Task watchdog on the WDT
+// <i> The WDT keeps running in sleep and pauses while a debugger halts the CPU
+//==========================================================
+#ifndef WATCHDOG_ENABLED
+#define WATCHDOG_ENABLED 1
+#endif
+// <o> WATCHDOG_CONFIG_TIMEOUT_MS - Reset after this long without a feed
+#ifndef WATCHDOG_CONFIG_TIMEOUT_MS
+#define WATCHDOG_CONFIG_TIMEOUT_MS 3000
+#endif
+
+// <o> WATCHDOG_CONFIG_CHECK_MS - Time between check-in reviews and feeds
+#ifndef WATCHDOG_CONFIG_CHECK_MS
+#define WATCHDOG_CONFIG_CHECK_MS 500
+#endif
+
+// <o> WATCHDOG_CONFIG_RENDER_DEADLINE_MS - Longest main loop pass gap
+#ifndef WATCHDOG_CONFIG_RENDER_DEADLINE_MS
+#define WATCHDOG_CONFIG_RENDER_DEADLINE_MS 1000
+#endif
+
+// <o> WATCHDOG_CONFIG_INPUT_DEADLINE_MS - Longest bottom half heartbeat gap
+#ifndef WATCHDOG_CONFIG_INPUT_DEADLINE_MS
+#define WATCHDOG_CONFIG_INPUT_DEADLINE_MS 1000
+#endif
+
+// </e>
+
+// <q> INPUT_BANK_ENABLED  - Extra inputs on the shared GPIOTE PORT event
+#ifndef INPUT_BANK_ENABLED
+#define INPUT_BANK_ENABLED 1
+#endif
+
+// <q> PROFILE_ENABLED  - DWT cycle profiling of PROFILE_BEGIN/END sites
+#ifndef PROFILE_ENABLED
+#define PROFILE_ENABLED 0
+#endif
+
+// <e> LATENCY_ENABLED - Measure button edge to LED change latency
+// <i> Needs EDGE_CAPTURE_ENABLED
+//==========================================================
+#ifndef LATENCY_ENABLED
+#define LATENCY_ENABLED 0
+#endif
+// <o> LATENCY_CONFIG_BUCKET_MS - Histogram bucket width
+#ifndef LATENCY_CONFIG_BUCKET_MS
+#define LATENCY_CONFIG_BUCKET_MS 50
+#endif
+
+// <o> LATENCY_CONFIG_TIMEOUT_MS - Longest latency attributed to an input
+#ifndef LATENCY_CONFIG_TIMEOUT_MS
+#define LATENCY_CONFIG_TIMEOUT_MS 2000
+#endif
+
+// </e>
+
+// <e> TRACE_ENABLED - Binary event trace in retained RAM
+//==========================================================
+#ifndef TRACE_ENABLED
+#define TRACE_ENABLED 0
+#endif
+// <o> TRACE_CONFIG_SIZE - Events kept, power of two (16 bytes each)
+#ifndef TRACE_CONFIG_SIZE
+#define TRACE_CONFIG_SIZE 256
+#endif
+
+// </e>
+
+// <o> CRASH_CONFIG_TRACE_TAIL - Newest trace events kept with a crash record
+// <i> Only filled with TRACE_ENABLED
+#ifndef CRASH_CONFIG_TRACE_TAIL
+#define CRASH_CONFIG_TRACE_TAIL 8
+#endif
+
+// <h> Input journal
+//==========================================================
+// <o> JOURNAL_CONFIG_SIZE - Retained journal entries, power of two
+#ifndef JOURNAL_CONFIG_SIZE
+#define JOURNAL_CONFIG_SIZE 64
+#endif
+
+// <q> JOURNAL_CONFIG_EDGES_ENABLED  - Also journal raw button edges
+#ifndef JOURNAL_CONFIG_EDGES_ENABLED
+#define JOURNAL_CONFIG_EDGES_ENABLED 0
+#endif
+
+// </h>
+
+// <h> Log levels
+// <i> Messages below a module's level are removed at compile time.
+// <i> Output goes to RTT and is written out from the idle loop.
+//==========================================================
+// <o> APP_CONFIG_LOG_LEVEL  - main.c diagnostics
+
+// <0=> Off
+// <1=> Error
+// <2=> Warning
+// <3=> Info
+// <4=> Debug
+
+#ifndef APP_CONFIG_LOG_LEVEL
+#define APP_CONFIG_LOG_LEVEL 3
+#endif
+
+// <o> ENCODER_CONFIG_LOG_LEVEL  - Rotary encoder
+
+// <0=> Off
+// <1=> Error
+// <2=> Warning
+// <3=> Info
+// <4=> Debug
+
+#ifndef ENCODER_CONFIG_LOG_LEVEL
+#define ENCODER_CONFIG_LOG_LEVEL 0
+#endif
+
+// <o> THERMAL_CONFIG_LOG_LEVEL  - Thermal derating
+
+// <0=> Off
+// <1=> Error
+// <2=> Warning
+// <3=> Info
+// <4=> Debug
+
+#ifndef THERMAL_CONFIG_LOG_LEVEL
+#define THERMAL_CONFIG_LOG_LEVEL 2
+#endif
+
+// </h>
+
+// <e> INPUT_BENCH_ENABLED - Benchmark IN event vs PORT event input at startup
+// <i> Needs INPUT_BENCH_OUT_PIN wired to INPUT_BENCH_IN_PIN.
+//==========================================================
+#ifndef INPUT_BENCH_ENABLED
+#define INPUT_BENCH_ENABLED 0
+#endif
+// <o> INPUT_BENCH_OUT_PIN - Stimulus output pin, absolute pin number (P0.13)
+#ifndef INPUT_BENCH_OUT_PIN
+#define INPUT_BENCH_OUT_PIN 13
+#endif
+
+// <o> INPUT_BENCH_IN_PIN - Input pin under test, absolute pin number (P0.15)
+#ifndef INPUT_BENCH_IN_PIN
+#define INPUT_BENCH_IN_PIN 15
+#endif
+
+// <o> INPUT_BENCH_SAMPLES - Edges measured per mode
+#ifndef INPUT_BENCH_SAMPLES
+#define INPUT_BENCH_SAMPLES 32
+#endif
+
+// <o> INPUT_BENCH_IDLE_MS - Standby window per mode for current measurement (ms)
+#ifndef INPUT_BENCH_IDLE_MS
+#define INPUT_BENCH_IDLE_MS 5000
+#endif
+
+// </e>
+
+// <q> EDGE_CAPTURE_ENABLED  - Timestamp button edges with TIMER1 capture through PPI
+// <i> Edge times are latched in hardware at 1 us resolution, independent of
+// <i> interrupt latency. Keeps TIMER1 running; when disabled the handler
+// <i> samples the RTC system time instead.
+
+#ifndef EDGE_CAPTURE_ENABLED
+#define EDGE_CAPTURE_ENABLED 1
+#endif
+
+// <h> Gesture timing
+
+//==========================================================
+// <o> GESTURE_CONFIG_CLICK_GAP_MS - Longest release between clicks of a multi-click
+#ifndef GESTURE_CONFIG_CLICK_GAP_MS
+#define GESTURE_CONFIG_CLICK_GAP_MS 400
+#endif
+
+// <o> GESTURE_CONFIG_LONG_PRESS_MS - Shortest press reported as a long press
+#ifndef GESTURE_CONFIG_LONG_PRESS_MS
+#define GESTURE_CONFIG_LONG_PRESS_MS 600
+#endif
+
+// <o> GESTURE_CONFIG_HOLD_MS - Press length at which a hold starts
+#ifndef GESTURE_CONFIG_HOLD_MS
+#define GESTURE_CONFIG_HOLD_MS 1200
+#endif
+
+// <o> GESTURE_CONFIG_HOLD_REPEAT_MS - Hold repeat interval
+#ifndef GESTURE_CONFIG_HOLD_REPEAT_MS
+#define GESTURE_CONFIG_HOLD_REPEAT_MS 200
+#endif
+
+// </h>
+//==========================================================
+
+// <o> TICKLESS_CONFIG_SLACK_MS - Lateness allowed for coroutine waits (ms)
+// <i> Timeouts whose windows overlap are served by a single RTC wakeup.
+
+#ifndef TICKLESS_CONFIG_SLACK_MS
+#define TICKLESS_CONFIG_SLACK_MS 2
+#endif
+
+// <o> TICKLESS_CONFIG_MAX_WINDOWS - Pending timeouts considered per sleep
+
+#ifndef TICKLESS_CONFIG_MAX_WINDOWS
+#define TICKLESS_CONFIG_MAX_WINDOWS 16
+#endif
+
+// <o> CPU_LOAD_CONFIG_WINDOW_MS - CPU load accounting window
+#ifndef CPU_LOAD_CONFIG_WINDOW_MS
+#define CPU_LOAD_CONFIG_WINDOW_MS 1000
+#endif
+
+// <o> CPU_LOAD_CONFIG_WINDOWS - Windows in the sliding average
+#ifndef CPU_LOAD_CONFIG_WINDOWS
+#define CPU_LOAD_CONFIG_WINDOWS 10
+#endif
+
+// <o> RUNTIME_STATS_CONFIG_REFRESH_MS - Refresh of runtime_stats_latest for debuggers, 0 for never
+#ifndef RUNTIME_STATS_CONFIG_REFRESH_MS
+#define RUNTIME_STATS_CONFIG_REFRESH_MS 1000
+#endif
+
+// </h>
+//==========================================================
+
 // <<< end of configuration section >>>
 #endif // SDK_CONFIG_H
@@ -0,0 +1,96 @@
+#ifndef CORO_H__
+#define CORO_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <sdk_config.h>
+#include "systime.h"
+#include "tickless.h"
+
+// Stackless (protothread-style) coroutines.
+//
+// A coroutine is an ordinary function taking a coro_t that is called over
+// and over from the main loop; every call resumes right after the wait it
+// last stopped at. There is no separate stack, so local variables do not
+// survive a wait: keep such state in statics or in a context struct.
+// The resume point is the source line, so use at most one wait per line
+// and do not wait inside a switch statement.
+
+typedef enum
+{
+    CORO_WAITING,
+    CORO_DONE
+} coro_status_t;
+
+typedef struct
+{
+    uint16_t line;
+    uint32_t until_ms;
+} coro_t;
+
+// One-shot event flag, may be signalled from interrupt context
+typedef volatile uint8_t coro_event_t;
+
+static inline void coro_event_signal(coro_event_t * p_event)
+{
+    *p_event = 1;
+    tickless_notify();
+}
+
+static inline bool coro_event_take(coro_event_t * p_event)
+{
+    if (!*p_event)
+        return false;
+    *p_event = 0;
+    return true;
+}
+
+// Timed waits tell the idle loop when to wake up, allowing
+// TICKLESS_CONFIG_SLACK_MS of lateness so they can share a wakeup
+static inline bool coro_deadline_reached(uint32_t until_ms)
+{
+    if (systime_reached(until_ms))
+        return true;
+    tickless_hint(until_ms, TICKLESS_CONFIG_SLACK_MS);
+    return false;
+}
+
+#define CORO_INIT(c) ((c)->line = 0)
+
+#define CORO_BEGIN(c) \
+    switch ((c)->line) \
+    {              \
+    case 0:
+
+#define CORO_END(c) \
+    }               \
+    (c)->line = 0;  \
+    return CORO_DONE
+
+#define CORO_WAIT_UNTIL(c, cond)          \
+    do                                    \
+    {                                     \
+        (c)->line = __LINE__;             \
+    case __LINE__:                        \
+        if (!(cond))                      \
+            return CORO_WAITING;          \
+    } while (0)
+
+#define CORO_YIELD(c)                     \
+    do                                    \
+    {                                     \
+        (c)->line = __LINE__;             \
+        return CORO_WAITING;              \
+    case __LINE__:;                       \
+    } while (0)
+
+#define CORO_WAIT_MS(c, ms)                                              \
+    do                                                                   \
+    {                                                                    \
+        (c)->until_ms = systime_ms() + (ms);                             \
+        CORO_WAIT_UNTIL(c, coro_deadline_reached((c)->until_ms));        \
+    } while (0)
+
+#define CORO_WAIT_EVENT(c, p_event) CORO_WAIT_UNTIL(c, coro_event_take(p_event))
+
+#endif // CORO_H__
@@ -0,0 +1,91 @@
+#include <nrfx.h>
+#include <sdk_config.h>
+#include "cpu_load.h"
+#include "systime.h"
+
+#define WINDOW_TICKS SYSTIME_MS_TO_TICKS(CPU_LOAD_CONFIG_WINDOW_MS)
+
+static uint64_t window_start = 0;
+static uint64_t window_sleep = 0;
+
+static uint16_t history[CPU_LOAD_CONFIG_WINDOWS];
+static uint32_t history_count = 0;
+
+static cpu_load_t load;
+
+static void window_close(void)
+{
+    uint32_t sum = 0;
+    uint32_t count;
+
+    load.last_permille = (uint16_t)(1000 - (window_sleep * 1000) / WINDOW_TICKS);
+    if (load.last_permille > load.peak_permille)
+        load.peak_permille = load.last_permille;
+
+    history[load.windows % CPU_LOAD_CONFIG_WINDOWS] = load.last_permille;
+    load.windows++;
+    if (history_count < CPU_LOAD_CONFIG_WINDOWS)
+        history_count++;
+
+    count = history_count;
+    for (uint32_t i = 0; i < count; i++)
+        sum += history[i];
+    load.avg_permille = (uint16_t)(sum / count);
+
+    window_start += WINDOW_TICKS;
+    window_sleep = 0;
+}
+
+// Books [start, end) as sleep, closing windows on the way
+static void sleep_book(uint64_t start, uint64_t end)
+{
+    while (end >= window_start + WINDOW_TICKS)
+    {
+        uint64_t boundary = window_start + WINDOW_TICKS;
+
+        if (start < boundary)
+        {
+            window_sleep += boundary - ((start > window_start) ? start : window_start);
+            start = boundary;
+        }
+        window_close();
+    }
+
+    if (start < end)
+        window_sleep += end - start;
+}
+
+void cpu_load_sleep_record(uint64_t sleep_start, uint64_t sleep_end)
+{
+    bool found = false;
+
+    sleep_book(sleep_start, sleep_end);
+
+    load.wakeups++;
+    for (uint32_t word = 0; word < (CPU_LOAD_IRQ_COUNT + 31) / 32; word++)
+    {
+        uint32_t pending = NVIC->ISPR[word];
+
+        while (pending)
+        {
+            uint32_t irq = word * 32 + __CLZ(__RBIT(pending));
+
+            if (irq < CPU_LOAD_IRQ_COUNT)
+                load.wakeups_by_irq[irq]++;
+            pending &= pending - 1;
+            found = true;
+        }
+    }
+    if (!found)
+        load.wakeups_unknown++;
+}
+
+void cpu_load_update(uint64_t now)
+{
+    sleep_book(now, now);
+}
+
+void cpu_load_get(cpu_load_t *p_load)
+{
+    *p_load = load;
+}
@@ -0,0 +1,36 @@
+#ifndef CPU_LOAD_H__
+#define CPU_LOAD_H__
+
+#include <stdint.h>
+
+// CPU load and wakeup accounting, fed by tickless_idle().
+//
+// Every sleep is timestamped on entry and exit with the RTC, and the time
+// asleep is booked into fixed windows of CPU_LOAD_CONFIG_WINDOW_MS. Load
+// is the awake share of a window. Right after WFI, still with interrupts
+// masked, the pending bits in NVIC->ISPR tell which interrupts ended the
+// sleep; each one is counted against its IRQ number.
+
+#define CPU_LOAD_IRQ_COUNT 48
+
+typedef struct
+{
+    uint16_t last_permille;  // last complete window
+    uint16_t avg_permille;   // over the last CPU_LOAD_CONFIG_WINDOWS windows
+    uint16_t peak_permille;  // worst window since boot
+    uint32_t windows;        // complete windows so far
+    uint32_t wakeups;        // sleeps ended
+    uint32_t wakeups_unknown; // sleeps ended with nothing pending
+    uint32_t wakeups_by_irq[CPU_LOAD_IRQ_COUNT];
+} cpu_load_t;
+
+// Books the sleep from sleep_start to sleep_end (systime ticks) and the
+// interrupts pending at wakeup. Call with interrupts still masked.
+void cpu_load_sleep_record(uint64_t sleep_start, uint64_t sleep_end);
+
+// Closes any windows that ended while the CPU stayed awake
+void cpu_load_update(uint64_t now);
+
+void cpu_load_get(cpu_load_t *p_load);
+
+#endif // CPU_LOAD_H__
@@ -0,0 +1,175 @@
+#include <nrfx.h>
+#include <app_error.h>
+#include <app_util_platform.h>
+#include <string.h>
+#include "crash.h"
+#include "systime.h"
+
+#define CRASH_MAGIC 0x43525332UL // "CRS2", bumped with the record layout
+
+// Cleared by crash_init() once taken, so a later plain reset reports nothing
+static crash_record_t record __attribute__((section(".noinit")));
+
+static crash_record_t last;
+static bool last_valid = false;
+
+static void capture_common(crash_type_t type)
+{
+    record.type = type;
+    record.ipsr = __get_IPSR();
+    // systime keeps counting in faults, unless the fault came from it
+    record.time_ms = systime_ms();
+    record.cfsr = SCB->CFSR;
+    record.hfsr = SCB->HFSR;
+    record.mmfar = SCB->MMFAR;
+    record.bfar = SCB->BFAR;
+    record.trace_count = trace_tail_get(record.trace, CRASH_CONFIG_TRACE_TAIL);
+}
+
+static void capture_done(void)
+{
+    record.magic = CRASH_MAGIC;
+    __DSB();
+
+#ifdef DEBUG
+    NRF_BREAKPOINT_COND;
+#endif
+    NVIC_SystemReset();
+}
+
+// Called from HardFault_Handler with the exception frame and EXC_RETURN.
+// Not static, the assembly below branches to it.
+void crash_hardfault(uint32_t const *p_frame, uint32_t exc_return)
+{
+    memset(&record, 0, sizeof(record));
+
+    record.r0 = p_frame[0];
+    record.r1 = p_frame[1];
+    record.r2 = p_frame[2];
+    record.r3 = p_frame[3];
+    record.r12 = p_frame[4];
+    record.lr = p_frame[5];
+    record.pc = p_frame[6];
+    record.xpsr = p_frame[7];
+    // 8 words, plus 18 more with a lazy FPU context and 1 for alignment
+    record.sp = (uint32_t)(uintptr_t)p_frame + ((exc_return & 0x10) ? 32 : 104) +
+                ((p_frame[7] & (1UL << 9)) ? 4 : 0);
+    record.exc_return = exc_return;
+
+    capture_common(CRASH_HARDFAULT);
+    capture_done();
+}
+
+// Picks the stack the fault was pushed on. After a stack overflow the
+// frame lies below __StackLimit, so the C part gets a fresh stack at the
+// top; it never returns, nothing there is needed any more. __StackLimit
+// and __StackTop come from nrf_common.ld.
+__attribute__((naked)) void HardFault_Handler(void)
+{
+    __ASM volatile(
+        "tst lr, #4             \n"
+        "ite eq                 \n"
+        "mrseq r0, msp          \n"
+        "mrsne r0, psp          \n"
+        "mov r1, lr             \n"
+        "ldr r2, =__StackLimit  \n"
+        "cmp r0, r2             \n"
+        "bhs 1f                 \n"
+        "ldr r2, =__StackTop    \n"
+        "mov sp, r2             \n"
+        "1:                     \n"
+        "b crash_hardfault      \n");
+}
+
+// Only the base name, the path is the same for every file
+static void file_name_copy(char const *p_path)
+{
+    char const *p_name = p_path;
+
+    if (p_path == NULL)
+        return;
+
+    for (char const *p = p_path; *p != '\0'; p++)
+    {
+        if (*p == '/' || *p == '\\')
+            p_name = p + 1;
+    }
+
+    // record was zeroed, so the last byte stays the terminator
+    strncpy(record.file, p_name, CRASH_FILE_NAME_SIZE - 1);
+}
+
+// Replaces the weak one in app_error_weak.c, which logs and resets
+void app_error_fault_handler(uint32_t id, uint32_t pc, uint32_t info)
+{
+    __disable_irq();
+    memset(&record, 0, sizeof(record));
+
+    record.fault_id = id;
+    record.pc = pc;
+    record.lr = (uint32_t)(uintptr_t)__builtin_return_address(0);
+    record.sp = __get_MSP();
+
+    switch (id)
+    {
+    case NRF_FAULT_ID_SDK_ERROR:
+    {
+        error_info_t const *p_info = (error_info_t const *)(uintptr_t)info;
+
+        record.error_code = p_info->err_code;
+        record.line = p_info->line_num;
+        file_name_copy((char const *)p_info->p_file_name);
+        capture_common(CRASH_APP_ERROR);
+        break;
+    }
+
+    case NRF_FAULT_ID_SDK_ASSERT:
+    {
+        assert_info_t const *p_info = (assert_info_t const *)(uintptr_t)info;
+
+        record.line = p_info->line_num;
+        file_name_copy((char const *)p_info->p_file_name);
+        capture_common(CRASH_ASSERT);
+        break;
+    }
+
+    default:
+        record.error_code = info;
+        capture_common(CRASH_OTHER);
+        break;
+    }
+
+    capture_done();
+}
+
+void crash_watchdog_capture(uint32_t task, uint32_t late_ms)
+{
+    memset(&record, 0, sizeof(record));
+
+    record.fault_id = task;
+    record.error_code = late_ms;
+    capture_common(CRASH_WATCHDOG);
+
+    // no NVIC_SystemReset(), so RESETREAS still shows the watchdog
+    record.magic = CRASH_MAGIC;
+    __DSB();
+}
+
+void crash_init(void)
+{
+    if (record.magic != CRASH_MAGIC)
+        return;
+
+    last = record;
+    last_valid = true;
+    record.magic = 0;
+}
+
+bool crash_get(crash_record_t *p_record)
+{
+    if (!last_valid)
+        return false;
+
+    *p_record = last;
+    return true;
+}
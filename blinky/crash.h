@@ -0,0 +1,59 @@
+#ifndef CRASH_H__
+#define CRASH_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <sdk_config.h>
+#include "trace.h"
+
+// Crash capture for the next boot.
+//
+// HardFault_Handler and app_error_fault_handler() (APP_ERROR_CHECK,
+// ASSERT) fill a record in .noinit RAM and reset. Nothing runs on the
+// normal path. After the reset crash_init() takes the record out, so it
+// is reported once, and crash_get() hands it to whoever prints it.
+// MemManage, BusFault and UsageFault are not enabled and escalate to
+// HardFault, so CFSR tells which one it was.
+
+// Source file base name kept with an error, cut to fit
+#define CRASH_FILE_NAME_SIZE 24
+
+typedef enum
+{
+    CRASH_HARDFAULT,
+    CRASH_APP_ERROR, // APP_ERROR_CHECK; error_code is the nRF error
+    CRASH_ASSERT,
+    CRASH_OTHER,     // app_error_fault_handler() with another fault id
+    CRASH_WATCHDOG   // WDT timeout; fault_id is the task, error_code how late (ms)
+} crash_type_t;
+
+typedef struct
+{
+    uint32_t magic;
+    uint32_t type;        // crash_type_t
+    uint32_t time_ms;     // systime of the crash, restarts every boot
+    uint32_t ipsr;        // active exception: 0 thread mode, 16 + IRQn
+    // stacked by the exception entry; for app errors only pc is known
+    uint32_t r0, r1, r2, r3, r12, lr, pc, xpsr;
+    uint32_t sp;          // before the exception frame was pushed
+    uint32_t exc_return;
+    uint32_t cfsr, hfsr, mmfar, bfar;
+    uint32_t fault_id;    // app_error_fault_handler() id
+    uint32_t error_code;
+    uint32_t line;
+    char file[CRASH_FILE_NAME_SIZE]; // copied, the next image may differ; "" if none
+    uint32_t trace_count;
+    trace_event_t trace[CRASH_CONFIG_TRACE_TAIL];
+} crash_record_t;
+
+// Records a watchdog timeout without resetting, the WDT does that.
+// Called from the WDT interrupt.
+void crash_watchdog_capture(uint32_t task, uint32_t late_ms);
+
+// Takes a crash record left by the previous run, if any
+void crash_init(void);
+
+// The record crash_init() found; false if the last reset was not a crash
+bool crash_get(crash_record_t *p_record);
+
+#endif // CRASH_H__
@@ -0,0 +1,24 @@
+#ifndef CYCLES_H__
+#define CYCLES_H__
+
+#include <stdint.h>
+#include <nrf.h>
+
+// Cortex-M4 DWT cycle counter. It counts CPU clock cycles (64 MHz) and
+// stops while the CPU sleeps, so use it for code that runs awake.
+
+#define CYCLES_PER_US (SystemCoreClock / 1000000UL)
+
+static inline void cycles_init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+static inline uint32_t cycles_now(void)
+{
+    return DWT->CYCCNT;
+}
+
+#endif // CYCLES_H__
@@ -0,0 +1,120 @@
+#include <sdk_config.h>
+#include "debounce.h"
+
+// worst_us moves 1/8 of the way down per clean burst
+#define DECAY_SHIFT 3
+
+static void lockout_update(debounce_t *p_debounce)
+{
+    uint32_t lockout = p_debounce->worst_us + p_debounce->worst_us / 2 + DEBOUNCE_CONFIG_FLOOR_US;
+
+    if (lockout > DEBOUNCE_CONFIG_CEILING_US)
+        lockout = DEBOUNCE_CONFIG_CEILING_US;
+    p_debounce->lockout_us = lockout;
+}
+
+static void bounce_learn(debounce_t *p_debounce, uint32_t span_us)
+{
+    if (span_us >= p_debounce->worst_us)
+        p_debounce->worst_us = span_us;
+    else
+        p_debounce->worst_us -= (p_debounce->worst_us - span_us) >> DECAY_SHIFT;
+
+    lockout_update(p_debounce);
+}
+
+void debounce_init(debounce_t *p_debounce, uint32_t level)
+{
+    *p_debounce = (debounce_t){.level = level};
+
+    // trust nothing until the switch has been seen
+    p_debounce->worst_us = DEBOUNCE_CONFIG_CEILING_US;
+    lockout_update(p_debounce);
+}
+
+static uint32_t lockout_left(debounce_t const *p_debounce, uint32_t now_us)
+{
+    uint32_t since_start = now_us - p_debounce->burst_start_us;
+
+    return (since_start < p_debounce->lockout_us) ? p_debounce->lockout_us - since_start : 0;
+}
+
+bool debounce_edge(debounce_t *p_debounce, uint32_t edge_us, uint32_t level)
+{
+    if (p_debounce->burst_valid)
+    {
+        uint32_t since_start = edge_us - p_debounce->burst_start_us;
+        uint32_t escape_window = 2 * p_debounce->lockout_us;
+
+        if (since_start < p_debounce->lockout_us)
+        {
+            p_debounce->burst_last_us = edge_us;
+            p_debounce->bounces++;
+            return false;
+        }
+
+        // the edge away was lost or taken as bounce, nothing changed
+        if (level == p_debounce->level)
+            return false;
+
+        if (escape_window > DEBOUNCE_CONFIG_CEILING_US)
+            escape_window = DEBOUNCE_CONFIG_CEILING_US;
+
+        if (since_start < escape_window)
+        {
+            // too soon for a finger, the lockout was too short
+            p_debounce->escapes++;
+            bounce_learn(p_debounce, since_start);
+        }
+        else
+        {
+            bounce_learn(p_debounce, p_debounce->burst_last_us - p_debounce->burst_start_us);
+        }
+    }
+
+    p_debounce->burst_start_us = edge_us;
+    p_debounce->burst_last_us = edge_us;
+    p_debounce->burst_valid = true;
+    p_debounce->bursts++;
+    p_debounce->level = level;
+    p_debounce->settling = true;
+    return true;
+}
+
+uint32_t debounce_settle(debounce_t *p_debounces, uint32_t count, uint32_t now_us,
+                         debounce_read_t read, debounce_report_t report)
+{
+    uint32_t first_us = DEBOUNCE_SETTLED;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        debounce_t *p_debounce = &p_debounces[i];
+        uint32_t left_us;
+
+        if (!p_debounce->settling)
+            continue;
+
+        left_us = lockout_left(p_debounce, now_us);
+        if (left_us == 0)
+        {
+            uint32_t level = read(i);
+
+            p_debounce->settling = false;
+            if (level != p_debounce->level)
+            {
+                p_debounce->burst_start_us = p_debounce->burst_last_us;
+                p_debounce->bursts++;
+                p_debounce->resyncs++;
+                p_debounce->level = level;
+                p_debounce->settling = true;
+                report(i, p_debounce->burst_start_us, level);
+                left_us = lockout_left(p_debounce, now_us);
+            }
+        }
+
+        if (p_debounce->settling && left_us < first_us)
+            first_us = left_us;
+    }
+
+    return first_us;
+}
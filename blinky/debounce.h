@@ -0,0 +1,64 @@
+#ifndef DEBOUNCE_H__
+#define DEBOUNCE_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Software debouncer that learns how long the switch bounces.
+//
+// After an accepted edge, further edges within the lockout are bounces.
+// When the next real edge arrives, the span of the finished burst feeds a
+// fast-attack, slow-decay estimate of the worst bounce, and the lockout
+// becomes 1.5x that estimate plus the floor, capped at the ceiling. An
+// accepted edge shortly after the lockout expired looks like a bounce
+// that outlasted it, so the estimate jumps to cover it. A clean switch
+// ends up near the floor; a worn one drifts back toward the ceiling.
+//
+// A real edge inside the lockout (a very short tap) is dropped with the
+// bounces, leaving the pin at a level no accepted edge reported. Once the
+// lockout is over, debounce_settle() reads the pin again and reports the
+// edge that was hidden.
+
+typedef struct
+{
+    uint32_t lockout_us;  // current lockout window
+    uint32_t worst_us;    // estimated worst-case bounce
+    uint32_t burst_start_us;
+    uint32_t burst_last_us;
+    bool burst_valid;
+    uint32_t level;       // level the last accepted edge left
+    bool settling;        // lockout since that edge not yet checked
+
+    uint32_t bursts;   // accepted edges
+    uint32_t bounces;  // edges rejected as bounce
+    uint32_t escapes;  // accepted edges that looked like escaped bounce
+    uint32_t resyncs;  // edges recovered once the lockout was over
+} debounce_t;
+
+// Current level of input index, for debounce_settle()
+typedef uint32_t (*debounce_read_t)(uint32_t index);
+
+// An edge found by debounce_settle(), reported like an accepted one
+typedef void (*debounce_report_t)(uint32_t index, uint32_t edge_us, uint32_t level);
+
+// debounce_settle() has nothing left to check
+#define DEBOUNCE_SETTLED UINT32_MAX
+
+// level is the input's level at startup
+void debounce_init(debounce_t *p_debounce, uint32_t level);
+
+// Feeds one edge and the level it left; returns true if it is a real edge.
+// An edge back to the accepted level is not one. Not reentrant, call all
+// of these functions from a single context.
+bool debounce_edge(debounce_t *p_debounce, uint32_t edge_us, uint32_t level);
+
+// Goes over count debouncers, read reading input i for p_debounces[i]. Each
+// one whose lockout has ended since its last accepted edge is read once
+// more; if the level differs, the last edge seen is reported and starts a
+// new burst, without learning from the one that hid it. now_us is on the
+// edge clock. Returns the lockout left on the first input still to be
+// checked, the time to call again, or DEBOUNCE_SETTLED.
+uint32_t debounce_settle(debounce_t *p_debounces, uint32_t count, uint32_t now_us,
+                         debounce_read_t read, debounce_report_t report);
+
+#endif // DEBOUNCE_H__
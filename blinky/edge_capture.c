@@ -0,0 +1,89 @@
+#include <nrfx_timer.h>
+#include <nrfx_ppi.h>
+#include <app_error.h>
+#include "edge_capture.h"
+#include "irq_priority.h"
+#include "energy.h"
+
+#if EDGE_CAPTURE_ENABLED
+
+// CC0..CC2 latch edges, CC3 is used to read the current time
+#define EDGE_CC_COUNT 3
+#define NOW_CC NRF_TIMER_CC_CHANNEL3
+// slot taken by something other than a pin
+#define NO_PIN ((nrfx_gpiote_pin_t)UINT32_MAX)
+
+static const nrfx_timer_t timer = NRFX_TIMER_INSTANCE(1);
+
+static nrfx_gpiote_pin_t edge_pins[EDGE_CC_COUNT];
+static uint8_t edge_pin_count = 0;
+
+static void timer_handler(nrf_timer_event_t event_type, void *p_context)
+{
+    // free-running, no compare interrupts are enabled
+}
+
+void edge_capture_init(void)
+{
+    nrfx_timer_config_t config = {
+        .frequency = NRF_TIMER_FREQ_1MHz,
+        .mode = NRF_TIMER_MODE_TIMER,
+        .bit_width = NRF_TIMER_BIT_WIDTH_32,
+        .interrupt_priority = IRQ_PRIORITY_LOW,
+        .p_context = NULL};
+
+    APP_ERROR_CHECK(nrfx_timer_init(&timer, &config, timer_handler));
+    nrfx_timer_enable(&timer);
+#if ENERGY_ENABLED
+    energy_hf_request(ENERGY_HF_EDGE_CAPTURE, true);
+#endif
+}
+
+void edge_capture_attach(nrfx_gpiote_pin_t pin)
+{
+    nrf_ppi_channel_t channel;
+    nrf_timer_cc_channel_t cc = (nrf_timer_cc_channel_t)edge_pin_count;
+
+    APP_ERROR_CHECK_BOOL(edge_pin_count < EDGE_CC_COUNT);
+
+    APP_ERROR_CHECK(nrfx_ppi_channel_alloc(&channel));
+    APP_ERROR_CHECK(nrfx_ppi_channel_assign(channel,
+                                            nrfx_gpiote_in_event_addr_get(pin),
+                                            nrfx_timer_capture_task_address_get(&timer, cc)));
+    APP_ERROR_CHECK(nrfx_ppi_channel_enable(channel));
+
+    edge_pins[edge_pin_count++] = pin;
+}
+
+uint32_t edge_capture_slot_alloc(uint8_t *p_slot)
+{
+    APP_ERROR_CHECK_BOOL(edge_pin_count < EDGE_CC_COUNT);
+
+    edge_pins[edge_pin_count] = NO_PIN;
+    *p_slot = edge_pin_count++;
+
+    return nrfx_timer_capture_task_address_get(&timer, *p_slot);
+}
+
+uint32_t edge_capture_slot_get_us(uint8_t slot)
+{
+    return nrfx_timer_capture_get(&timer, (nrf_timer_cc_channel_t)slot);
+}
+
+uint32_t edge_capture_get_us(nrfx_gpiote_pin_t pin)
+{
+    for (uint8_t i = 0; i < edge_pin_count; i++)
+    {
+        if (edge_pins[i] == pin)
+            return nrfx_timer_capture_get(&timer, (nrf_timer_cc_channel_t)i);
+    }
+
+    return edge_capture_now_us();
+}
+
+uint32_t edge_capture_now_us(void)
+{
+    return nrfx_timer_capture(&timer, NOW_CC);
+}
+
+#endif // EDGE_CAPTURE_ENABLED
@@ -0,0 +1,29 @@
+#ifndef EDGE_CAPTURE_H__
+#define EDGE_CAPTURE_H__
+
+#include <stdint.h>
+#include <nrfx_gpiote.h>
+
+// Hardware edge timestamps. TIMER1 free-runs at 1 MHz and the GPIOTE IN
+// event of each attached pin triggers a TIMER1 CAPTURE task through PPI,
+// so the time is latched by the edge itself, not by the interrupt handler.
+// Only the latest edge per pin is kept, read it from that pin's handler.
+
+void edge_capture_init(void);
+
+// Pin must already be set up as a high-accuracy GPIOTE input
+void edge_capture_attach(nrfx_gpiote_pin_t pin);
+
+// Takes a capture slot for an event other than a pin edge. Returns the
+// CAPTURE task address to trigger through PPI.
+uint32_t edge_capture_slot_alloc(uint8_t *p_slot);
+
+uint32_t edge_capture_slot_get_us(uint8_t slot);
+
+// Time of the last edge on pin, in microseconds
+uint32_t edge_capture_get_us(nrfx_gpiote_pin_t pin);
+
+// Current time on the same clock
+uint32_t edge_capture_now_us(void);
+
+#endif // EDGE_CAPTURE_H__
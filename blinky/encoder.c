@@ -0,0 +1,87 @@
+#include <nrfx_qdec.h>
+#include <nrf_gpio.h>
+#include <app_error.h>
+#include "encoder.h"
+#include "bottom_half.h"
+#include "irq_priority.h"
+#include "energy.h"
+#include "runtime_stats.h"
+
+#if ENCODER_ENABLED
+
+#define NRF_LOG_MODULE_NAME encoder
+#define NRF_LOG_LEVEL ENCODER_CONFIG_LOG_LEVEL
+#include <nrf_log.h>
+NRF_LOG_MODULE_REGISTER();
+
+static encoder_handler_t encoder_handler;
+static int32_t pending_steps = 0;
+static encoder_stats_t stats;
+
+// Bottom half: steps left over from a partial detent carry to the next report
+static void encoder_process(uint32_t acc, uint32_t accdbl)
+{
+    int32_t detents;
+
+    pending_steps += (int16_t)acc;
+    detents = pending_steps / ENCODER_CONFIG_STEPS_PER_DETENT;
+    pending_steps -= detents * ENCODER_CONFIG_STEPS_PER_DETENT;
+
+    stats.steps += ((int16_t)acc < 0) ? -(int16_t)acc : (int16_t)acc;
+    stats.doubles += accdbl;
+    NRF_LOG_DEBUG("acc %d accdbl %u, %d detents", (int16_t)acc, accdbl, detents);
+
+    if (detents != 0)
+        encoder_handler(detents);
+}
+
+// Top half
+static void qdec_handler(nrfx_qdec_event_t event)
+{
+    if (event.type != NRF_QDEC_EVENT_REPORTRDY)
+        return;
+
+    TOP_HALF_BEGIN();
+
+    stats.reports++;
+    RUNTIME_STATS_INC(input_events);
+    bottom_half_post(encoder_process, (uint16_t)event.data.report.acc, event.data.report.accdbl);
+
+    TOP_HALF_END();
+}
+
+void encoder_init(uint32_t pin_a, uint32_t pin_b, encoder_handler_t handler)
+{
+    nrfx_qdec_config_t config = {
+        .reportper = (nrf_qdec_reportper_t)ENCODER_CONFIG_REPORTPER,
+        .sampleper = (nrf_qdec_sampleper_t)ENCODER_CONFIG_SAMPLEPER,
+        .psela = pin_a,
+        .pselb = pin_b,
+        .pselled = NRF_QDEC_LED_NOT_CONNECTED,
+        .ledpre = 0,
+        .ledpol = NRF_QDEC_LEPOL_ACTIVE_HIGH,
+        .dbfen = true,
+        .sample_inten = false,
+        .interrupt_priority = IRQ_PRIORITY_INPUT};
+
+    encoder_handler = handler;
+
+    APP_ERROR_CHECK(nrfx_qdec_init(&config, qdec_handler));
+
+    // the driver leaves the inputs floating; mechanical encoders switch to ground
+    nrf_gpio_cfg_input(pin_a, NRF_GPIO_PIN_PULLUP);
+    nrf_gpio_cfg_input(pin_b, NRF_GPIO_PIN_PULLUP);
+
+    nrfx_qdec_enable();
+#if ENERGY_ENABLED
+    energy_hf_request(ENERGY_HF_QDEC, true);
+    energy_qdec_set(true);
+#endif
+}
+
+void encoder_stats_get(encoder_stats_t *p_stats)
+{
+    *p_stats = stats;
+}
+
+#endif // ENCODER_ENABLED
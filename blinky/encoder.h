@@ -0,0 +1,26 @@
+#ifndef ENCODER_H__
+#define ENCODER_H__
+
+#include <stdint.h>
+
+// Rotary encoder on the QDEC peripheral. QDEC decodes the quadrature
+// signal in hardware and accumulates steps; it interrupts once per report
+// period, and only when the knob has moved, so a fast spin costs one
+// interrupt every few ms instead of one per detent. The top half posts
+// the accumulated count to the bottom half, which turns it into detents.
+
+typedef struct
+{
+    uint32_t reports; // REPORTRDY interrupts
+    uint32_t steps;   // quadrature steps seen, either direction
+    uint32_t doubles; // double transitions, i.e. steps QDEC could not decode
+} encoder_stats_t;
+
+// Called from the bottom half with whole detents moved, positive clockwise
+typedef void (*encoder_handler_t)(int32_t detents);
+
+void encoder_init(uint32_t pin_a, uint32_t pin_b, encoder_handler_t handler);
+
+void encoder_stats_get(encoder_stats_t *p_stats);
+
+#endif // ENCODER_H__
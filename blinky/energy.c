@@ -0,0 +1,153 @@
+#include <nrfx.h>
+#include "energy.h"
+#include "systime.h"
+
+#if ENERGY_ENABLED
+
+#define TICKS_PER_HOUR (SYSTIME_TICK_HZ * 3600ULL)
+
+static const uint32_t led_ua[ENERGY_LED_COUNT] = {
+    ENERGY_CONFIG_LED_1_UA,
+    ENERGY_CONFIG_LED_R_UA,
+    ENERGY_CONFIG_LED_G_UA,
+    ENERGY_CONFIG_LED_B_UA};
+
+static uint64_t start;
+static uint64_t sleep_ticks;
+
+static uint32_t hf_users;
+static uint64_t hf_since;
+static uint64_t hf_ticks;
+
+// A peripheral that is either running or not
+typedef struct
+{
+    bool running;
+    uint64_t since;
+    uint64_t ticks;
+} span_t;
+
+static span_t pwm;
+static span_t qdec;
+
+static uint16_t led_duty[ENERGY_LED_COUNT];
+static uint64_t led_since[ENERGY_LED_COUNT];
+static uint64_t led_permille_ticks[ENERGY_LED_COUNT]; // duty * ticks
+
+void energy_init(void)
+{
+    uint64_t now = systime_ticks();
+
+    start = now;
+    hf_since = now;
+    pwm.since = now;
+    qdec.since = now;
+    for (uint32_t i = 0; i < ENERGY_LED_COUNT; i++)
+        led_since[i] = now;
+}
+
+void energy_sleep_record(uint64_t sleep_start, uint64_t sleep_end)
+{
+    sleep_ticks += sleep_end - sleep_start;
+}
+
+void energy_hf_request(energy_hf_user_t user, bool on)
+{
+    uint64_t now = systime_ticks();
+
+    NRFX_CRITICAL_SECTION_ENTER();
+    if (hf_users)
+        hf_ticks += now - hf_since;
+    hf_since = now;
+
+    if (on)
+        hf_users |= 1UL << user;
+    else
+        hf_users &= ~(1UL << user);
+    NRFX_CRITICAL_SECTION_EXIT();
+}
+
+static void span_set(span_t *p_span, bool running)
+{
+    uint64_t now = systime_ticks();
+
+    NRFX_CRITICAL_SECTION_ENTER();
+    if (p_span->running)
+        p_span->ticks += now - p_span->since;
+    p_span->since = now;
+    p_span->running = running;
+    NRFX_CRITICAL_SECTION_EXIT();
+}
+
+// Closed and open time together; call inside the critical section
+static uint64_t span_ticks(span_t const *p_span, uint64_t now)
+{
+    return p_span->ticks + (p_span->running ? now - p_span->since : 0);
+}
+
+void energy_pwm_set(bool running)
+{
+    span_set(&pwm, running);
+}
+
+void energy_qdec_set(bool running)
+{
+    span_set(&qdec, running);
+}
+
+void energy_led_set(energy_led_t led, uint16_t duty)
+{
+    uint64_t now = systime_ticks();
+
+    NRFX_CRITICAL_SECTION_ENTER();
+    led_permille_ticks[led] += (uint64_t)led_duty[led] * (now - led_since[led]);
+    led_since[led] = now;
+    led_duty[led] = duty;
+    NRFX_CRITICAL_SECTION_EXIT();
+}
+
+static uint32_t average_ua(uint64_t ua_ticks, uint64_t elapsed)
+{
+    return elapsed ? (uint32_t)(ua_ticks / elapsed) : 0;
+}
+
+void energy_get(energy_t *p_energy)
+{
+    uint64_t ua_ticks[ENERGY_PART_COUNT] = {0};
+    uint64_t now = systime_ticks();
+    uint64_t elapsed;
+
+    // close the open intervals up to now, without moving them
+    NRFX_CRITICAL_SECTION_ENTER();
+    elapsed = now - start;
+    p_energy->elapsed_ticks = elapsed;
+    p_energy->active_ticks = (sleep_ticks < elapsed) ? elapsed - sleep_ticks : 0;
+    p_energy->hfclk_ticks = hf_ticks + (hf_users ? now - hf_since : 0);
+    p_energy->pwm_ticks = span_ticks(&pwm, now);
+    p_energy->qdec_ticks = span_ticks(&qdec, now);
+    for (uint32_t i = 0; i < ENERGY_LED_COUNT; i++)
+    {
+        uint64_t permille_ticks = led_permille_ticks[i] + (uint64_t)led_duty[i] * (now - led_since[i]);
+
+        p_energy->led_ticks[i] = permille_ticks / 1000;
+        ua_ticks[ENERGY_PART_LED] += permille_ticks / 1000 * led_ua[i];
+    }
+    NRFX_CRITICAL_SECTION_EXIT();
+
+    ua_ticks[ENERGY_PART_SLEEP] = elapsed * ENERGY_CONFIG_SLEEP_UA;
+    ua_ticks[ENERGY_PART_CPU] = p_energy->active_ticks * ENERGY_CONFIG_CPU_UA;
+    ua_ticks[ENERGY_PART_HFCLK] = p_energy->hfclk_ticks * ENERGY_CONFIG_HFCLK_UA;
+    ua_ticks[ENERGY_PART_PWM] = p_energy->pwm_ticks * ENERGY_CONFIG_PWM_UA;
+    ua_ticks[ENERGY_PART_QDEC] = p_energy->qdec_ticks * ENERGY_CONFIG_QDEC_UA;
+
+    uint64_t total = 0;
+    for (uint32_t part = 0; part < ENERGY_PART_COUNT; part++)
+    {
+        p_energy->avg_ua[part] = average_ua(ua_ticks[part], elapsed);
+        total += ua_ticks[part];
+    }
+    p_energy->total_avg_ua = average_ua(total, elapsed);
+    p_energy->charge_uah = (uint32_t)(total / TICKS_PER_HOUR);
+}
+
+#endif // ENERGY_ENABLED
@@ -0,0 +1,79 @@
+#ifndef ENERGY_H__
+#define ENERGY_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <sdk_config.h>
+
+// Energy estimate from time spent in each power state.
+//
+// Callers report state changes; the module integrates time per state in
+// RTC ticks and weighs it with the current model in sdk_config.h
+// (ENERGY_CONFIG_*_UA). The sleep floor is always drawn, the CPU current
+// only while awake, the HF clock current while a peripheral that needs it
+// runs, the PWM and QDEC currents while they run, and each LED's current
+// in proportion to its PWM duty. Short
+// users of the HF clock (debounce timer, SAADC conversions) are not
+// tracked. It is a model, not a measurement: use it to compare settings.
+
+typedef enum
+{
+    ENERGY_LED_1,
+    ENERGY_LED_R,
+    ENERGY_LED_G,
+    ENERGY_LED_B,
+    ENERGY_LED_COUNT
+} energy_led_t;
+
+// Peripherals that keep the HF clock running
+typedef enum
+{
+    ENERGY_HF_PWM,
+    ENERGY_HF_EDGE_CAPTURE,
+    ENERGY_HF_QDEC
+} energy_hf_user_t;
+
+typedef enum
+{
+    ENERGY_PART_SLEEP, // floor: System ON idle, RTC, RAM retention
+    ENERGY_PART_CPU,
+    ENERGY_PART_HFCLK,
+    ENERGY_PART_PWM,
+    ENERGY_PART_QDEC,
+    ENERGY_PART_LED,   // all LEDs, duty weighted
+    ENERGY_PART_COUNT
+} energy_part_t;
+
+typedef struct
+{
+    uint64_t elapsed_ticks;                   // since energy_init()
+    uint64_t active_ticks;                    // CPU awake
+    uint64_t hfclk_ticks;
+    uint64_t pwm_ticks;
+    uint64_t qdec_ticks;
+    uint64_t led_ticks[ENERGY_LED_COUNT];     // full-on equivalent
+    uint32_t avg_ua[ENERGY_PART_COUNT];       // average current per part
+    uint32_t total_avg_ua;
+    uint32_t charge_uah;                      // estimated since energy_init()
+} energy_t;
+
+// Starts the books; call once systime runs, before any other energy call.
+// Anything before it, such as the input benchmark, is left out.
+void energy_init(void);
+
+// Books [sleep_start, sleep_end) in systime ticks as CPU asleep
+void energy_sleep_record(uint64_t sleep_start, uint64_t sleep_end);
+
+void energy_hf_request(energy_hf_user_t user, bool on);
+
+void energy_pwm_set(bool running);
+
+// The QDEC samples continuously while enabled
+void energy_qdec_set(bool running);
+
+// LED duty in permille of full on; 0 when the LED is off
+void energy_led_set(energy_led_t led, uint16_t duty);
+
+void energy_get(energy_t *p_energy);
+
+#endif // ENERGY_H__
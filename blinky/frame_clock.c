@@ -0,0 +1,92 @@
+#include <nrfx_timer.h>
+#include <nrfx_ppi.h>
+#include <app_error.h>
+#include "frame_clock.h"
+#include "irq_priority.h"
+#include "trace.h"
+#include "bottom_half.h"
+
+static const nrfx_timer_t timer = NRFX_TIMER_INSTANCE(2);
+
+static coro_event_t frame_event = 0;
+static frame_clock_stats_t stats;
+static volatile uint32_t users;
+
+static void timer_handler(nrf_timer_event_t event_type, void *p_context)
+{
+    if (event_type != NRF_TIMER_EVENT_COMPARE0)
+        return;
+
+    TOP_HALF_BEGIN();
+
+    stats.frames++;
+    TRACE_INSTANT(TRACE_ID_FRAME, stats.frames, 0);
+    if (frame_event && (users & FRAME_CLOCK_RENDERER))
+        stats.missed++;
+
+    coro_event_signal(&frame_event);
+
+    TOP_HALF_END();
+}
+
+void frame_clock_init(uint32_t period_event_addr, uint32_t periods_per_frame)
+{
+    nrf_ppi_channel_t channel;
+    nrfx_timer_config_t config = {
+        .frequency = NRF_TIMER_FREQ_1MHz,
+        .mode = NRF_TIMER_MODE_LOW_POWER_COUNTER,
+        .bit_width = NRF_TIMER_BIT_WIDTH_16,
+        .interrupt_priority = IRQ_PRIORITY_OUTPUT,
+        .p_context = NULL};
+
+    APP_ERROR_CHECK(nrfx_timer_init(&timer, &config, timer_handler));
+    nrfx_timer_extended_compare(&timer, NRF_TIMER_CC_CHANNEL0, periods_per_frame,
+                                NRF_TIMER_SHORT_COMPARE0_CLEAR_MASK, true);
+
+    APP_ERROR_CHECK(nrfx_ppi_channel_alloc(&channel));
+    APP_ERROR_CHECK(nrfx_ppi_channel_assign(channel, period_event_addr,
+                                            nrfx_timer_task_address_get(&timer, NRF_TIMER_TASK_COUNT)));
+    APP_ERROR_CHECK(nrfx_ppi_channel_enable(channel));
+
+    // stopped until a user needs frames
+    nrfx_timer_enable(&timer);
+    nrfx_timer_pause(&timer);
+}
+
+void frame_clock_request(uint32_t user, bool needed)
+{
+    uint32_t was = users;
+
+    users = needed ? (was | user) : (was & ~user);
+    if (users == was)
+        return;
+
+    if (users == 0)
+    {
+        nrfx_timer_pause(&timer);
+        return;
+    }
+
+    if ((users & ~was) & FRAME_CLOCK_RENDERER)
+        frame_event = 0;
+    if (was == 0)
+    {
+        nrfx_timer_clear(&timer);
+        nrfx_timer_resume(&timer);
+    }
+}
+
+coro_event_t *frame_clock_event(void)
+{
+    return &frame_event;
+}
+
+uint32_t frame_clock_count(void)
+{
+    return stats.frames;
+}
+
+void frame_clock_stats_get(frame_clock_stats_t *p_stats)
+{
+    *p_stats = stats;
+}
@@ -0,0 +1,40 @@
+#ifndef FRAME_CLOCK_H__
+#define FRAME_CLOCK_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "coro.h"
+
+// Frame pacing from the PWM output itself. PWM period-end events are
+// counted in hardware (PPI into TIMER2 in low-power counter mode) and only
+// every Nth period raises an interrupt, which signals the frame event.
+// Frames are therefore phase-locked to the PWM and a duty written right
+// after the event is picked up at the next period boundary.
+//
+// The clock only runs while some user needs it, so a paused fade costs
+// no wakeups. Users are bits chosen by the caller; FRAME_CLOCK_RENDERER is
+// the one that takes frame_clock_event() and the only one that can miss.
+
+#define FRAME_CLOCK_RENDERER 0x01
+
+typedef struct
+{
+    uint32_t frames; // frame events raised
+    uint32_t missed; // frame events raised before the renderer took the previous one
+} frame_clock_stats_t;
+
+// period_event_addr is the PWM PWMPERIODEND (or SEQEND) event address
+void frame_clock_init(uint32_t period_event_addr, uint32_t periods_per_frame);
+
+// Thread mode only. Starting the clock restarts the frame, and a renderer
+// coming back never sees an event left over from before its pause.
+void frame_clock_request(uint32_t user, bool needed);
+
+coro_event_t *frame_clock_event(void);
+
+// Frames since start, for waiters other than the one taking the event
+uint32_t frame_clock_count(void);
+
+void frame_clock_stats_get(frame_clock_stats_t *p_stats);
+
+#endif // FRAME_CLOCK_H__
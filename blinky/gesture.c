@@ -0,0 +1,181 @@
+#include <stddef.h>
+#include <sdk_config.h>
+#include "gesture.h"
+#include "tickless.h"
+#include "bottom_half.h"
+#include "systime.h"
+
+// Clicks beyond this are not waited for, the triple click fires on release
+#define MAX_CLICKS 3
+
+typedef enum
+{
+    ST_IDLE,
+    ST_DOWN,      // pressed, shorter than a long press so far
+    ST_DOWN_LONG, // pressed past LONG_PRESS_MS
+    ST_HOLD,      // pressed past HOLD_MS, repeating
+    ST_UP         // released, waiting to see if another click follows
+} state_t;
+
+typedef enum
+{
+    IN_PRESS,
+    IN_RELEASE,
+    IN_TIMEOUT
+} input_t;
+
+typedef struct
+{
+    state_t state;
+    input_t input;
+    bool (*guard)(void);
+    void (*action)(uint32_t time_us);
+    state_t next;
+    uint32_t timeout_ms; // armed on entering next, 0 for none
+} transition_t;
+
+static gesture_handler_t gesture_handler;
+static tickless_timer_t timer;
+
+static state_t state = ST_IDLE;
+static uint8_t clicks;
+static uint32_t start_us;
+static uint32_t last_edge_us;
+static uint32_t timeout_due_us;
+static uint32_t timeout_due_ms;
+// Bumped on every state change, so a timeout that was already posted when
+// the state moved on is recognised as stale
+static uint32_t timer_generation;
+
+static void emit(gesture_type_t type, uint32_t time_us)
+{
+    gesture_event_t event = {
+        .type = type,
+        .start_us = start_us,
+        .time_us = time_us,
+        .edge_us = last_edge_us};
+
+    gesture_handler(&event);
+}
+
+static void emit_clicks(uint32_t time_us)
+{
+    static const gesture_type_t click_gestures[] = {
+        GESTURE_SINGLE_CLICK, GESTURE_DOUBLE_CLICK, GESTURE_TRIPLE_CLICK};
+
+    emit(click_gestures[clicks - 1], time_us);
+}
+
+static bool is_last_click(void)
+{
+    return clicks + 1 >= MAX_CLICKS;
+}
+
+static void on_first_press(uint32_t time_us)
+{
+    clicks = 0;
+    start_us = time_us;
+}
+
+static void on_click(uint32_t time_us)
+{
+    clicks++;
+}
+
+static void on_last_click(uint32_t time_us)
+{
+    clicks++;
+    emit_clicks(time_us);
+}
+
+static void on_long_press(uint32_t time_us)
+{
+    emit(GESTURE_LONG_PRESS, time_us);
+}
+
+static void on_hold_start(uint32_t time_us)
+{
+    emit(GESTURE_HOLD_START, time_us);
+}
+
+static void on_hold_repeat(uint32_t time_us)
+{
+    emit(GESTURE_HOLD_REPEAT, time_us);
+}
+
+static void on_hold_end(uint32_t time_us)
+{
+    emit(GESTURE_HOLD_END, time_us);
+}
+
+// First matching row wins; inputs with no row are ignored (e.g. a release
+// while idle after a missed press)
+static const transition_t transitions[] = {
+    {ST_IDLE,      IN_PRESS,   NULL,          on_first_press, ST_DOWN,      GESTURE_CONFIG_LONG_PRESS_MS},
+    {ST_UP,        IN_PRESS,   NULL,          NULL,           ST_DOWN,      GESTURE_CONFIG_LONG_PRESS_MS},
+    {ST_DOWN,      IN_RELEASE, is_last_click, on_last_click,  ST_IDLE,      0},
+    {ST_DOWN,      IN_RELEASE, NULL,          on_click,       ST_UP,        GESTURE_CONFIG_CLICK_GAP_MS},
+    {ST_DOWN,      IN_TIMEOUT, NULL,          NULL,           ST_DOWN_LONG, GESTURE_CONFIG_HOLD_MS - GESTURE_CONFIG_LONG_PRESS_MS},
+    {ST_DOWN_LONG, IN_RELEASE, NULL,          on_long_press,  ST_IDLE,      0},
+    {ST_DOWN_LONG, IN_TIMEOUT, NULL,          on_hold_start,  ST_HOLD,      GESTURE_CONFIG_HOLD_REPEAT_MS},
+    {ST_HOLD,      IN_TIMEOUT, NULL,          on_hold_repeat, ST_HOLD,      GESTURE_CONFIG_HOLD_REPEAT_MS},
+    {ST_HOLD,      IN_RELEASE, NULL,          on_hold_end,    ST_IDLE,      0},
+    {ST_UP,        IN_TIMEOUT, NULL,          emit_clicks,    ST_IDLE,      0},
+};
+
+static void step(input_t input, uint32_t time_us)
+{
+    for (size_t i = 0; i < sizeof(transitions) / sizeof(transitions[0]); i++)
+    {
+        transition_t const *p_row = &transitions[i];
+
+        if (p_row->state != state || p_row->input != input)
+            continue;
+        if (p_row->guard != NULL && !p_row->guard())
+            continue;
+
+        if (p_row->action != NULL)
+            p_row->action(time_us);
+
+        state = p_row->next;
+        timer_generation++;
+
+        if (p_row->timeout_ms != 0)
+        {
+            timeout_due_us = time_us + p_row->timeout_ms * 1000;
+            timeout_due_ms = systime_ms() + p_row->timeout_ms;
+            tickless_timer_start(&timer, p_row->timeout_ms, TICKLESS_CONFIG_SLACK_MS);
+        }
+        else
+        {
+            tickless_timer_stop(&timer);
+        }
+        return;
+    }
+}
+
+static void timeout_process(uint32_t generation, uint32_t unused)
+{
+    // the timer may have been re-armed between expiring and being posted
+    if (generation == timer_generation && systime_reached(timeout_due_ms))
+        step(IN_TIMEOUT, timeout_due_us);
+}
+
+// Tickless timers run in thread mode; hand the timeout to the bottom half
+// so the state machine only ever runs in one context
+static void timer_handler(void *p_context)
+{
+    bottom_half_post(timeout_process, timer_generation, 0);
+}
+
+void gesture_init(gesture_handler_t handler)
+{
+    gesture_handler = handler;
+    tickless_timer_init(&timer, timer_handler, NULL);
+}
+
+void gesture_input(bool pressed, uint32_t edge_us)
+{
+    last_edge_us = edge_us;
+    step(pressed ? IN_PRESS : IN_RELEASE, edge_us);
+}
@@ -0,0 +1,38 @@
+#ifndef GESTURE_H__
+#define GESTURE_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Button gesture recognizer. Debounced press/release edges go in, gesture
+// events come out. The recognizer is a transition table, see gesture.c.
+// Timings are GESTURE_CONFIG_* in sdk_config.h.
+
+typedef enum
+{
+    GESTURE_SINGLE_CLICK,
+    GESTURE_DOUBLE_CLICK,
+    GESTURE_TRIPLE_CLICK,
+    GESTURE_LONG_PRESS,  // released after LONG_PRESS_MS but before HOLD_MS
+    GESTURE_HOLD_START,  // still pressed after HOLD_MS
+    GESTURE_HOLD_REPEAT, // every HOLD_REPEAT_MS while held
+    GESTURE_HOLD_END     // released after HOLD_START
+} gesture_type_t;
+
+typedef struct
+{
+    gesture_type_t type;
+    uint32_t start_us; // first press of the gesture
+    uint32_t time_us;  // edge that completed it, or when its timeout was due
+    uint32_t edge_us;  // last button edge before it, where a user's wait starts
+} gesture_event_t;
+
+typedef void (*gesture_handler_t)(gesture_event_t const *p_event);
+
+// Handler is called from the bottom half
+void gesture_init(gesture_handler_t handler);
+
+// Feeds one debounced edge. Call from the bottom half only.
+void gesture_input(bool pressed, uint32_t edge_us);
+
+#endif // GESTURE_H__
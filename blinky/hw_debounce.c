@@ -0,0 +1,70 @@
+#include <nrfx_timer.h>
+#include <nrfx_ppi.h>
+#include <app_error.h>
+#include "hw_debounce.h"
+#include "irq_priority.h"
+#include "bottom_half.h"
+#include "runtime_stats.h"
+
+#if BUTTON_HW_DEBOUNCE_ENABLED
+
+static const nrfx_timer_t timer = NRFX_TIMER_INSTANCE(3);
+
+static nrfx_gpiote_pin_t debounce_pin;
+static uint32_t stable_level;
+static hw_debounce_handler_t debounce_handler;
+
+static void timer_handler(nrf_timer_event_t event_type, void *p_context)
+{
+    if (event_type != NRF_TIMER_EVENT_COMPARE0)
+        return;
+
+    TOP_HALF_BEGIN();
+    uint32_t level = nrf_gpio_pin_read(debounce_pin);
+
+    if (level == stable_level)
+    {
+        // bounced back to where it was
+        RUNTIME_STATS_INC(debounce_rejections);
+    }
+    else
+    {
+        stable_level = level;
+        debounce_handler(debounce_pin, level);
+    }
+
+    TOP_HALF_END();
+}
+
+void hw_debounce_init(nrfx_gpiote_pin_t pin, uint32_t quiet_us, hw_debounce_handler_t handler)
+{
+    nrf_ppi_channel_t channel;
+    nrfx_timer_config_t config = {
+        .frequency = NRF_TIMER_FREQ_1MHz,
+        .mode = NRF_TIMER_MODE_TIMER,
+        .bit_width = NRF_TIMER_BIT_WIDTH_32,
+        .interrupt_priority = IRQ_PRIORITY_INPUT,
+        .p_context = NULL};
+
+    debounce_pin = pin;
+    debounce_handler = handler;
+    stable_level = nrf_gpio_pin_read(pin);
+
+    APP_ERROR_CHECK(nrfx_timer_init(&timer, &config, timer_handler));
+    // one-shot: stops itself when the quiet period has elapsed
+    nrfx_timer_extended_compare(&timer, NRF_TIMER_CC_CHANNEL0, quiet_us,
+                                NRF_TIMER_SHORT_COMPARE0_STOP_MASK, true);
+
+    APP_ERROR_CHECK(nrfx_ppi_channel_alloc(&channel));
+    APP_ERROR_CHECK(nrfx_ppi_channel_assign(channel,
+                                            nrfx_gpiote_in_event_addr_get(pin),
+                                            nrfx_timer_task_address_get(&timer, NRF_TIMER_TASK_CLEAR)));
+    APP_ERROR_CHECK(nrfx_ppi_channel_fork_assign(channel,
+                                                 nrfx_timer_task_address_get(&timer, NRF_TIMER_TASK_START)));
+    APP_ERROR_CHECK(nrfx_ppi_channel_enable(channel));
+
+    // event routed to PPI only, no GPIOTE interrupt
+    nrfx_gpiote_in_event_enable(pin, false);
+}
+
+#endif // BUTTON_HW_DEBOUNCE_ENABLED
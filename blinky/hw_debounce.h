@@ -0,0 +1,20 @@
+#ifndef HW_DEBOUNCE_H__
+#define HW_DEBOUNCE_H__
+
+#include <stdint.h>
+#include <nrfx_gpiote.h>
+
+// Debouncing without CPU wakeups on bounce. Every GPIOTE IN edge of the
+// pin restarts TIMER3 through PPI (CLEAR + START) and the GPIOTE interrupt
+// stays disabled. Only when the pin has been quiet for quiet_us does the
+// TIMER3 compare fire; its interrupt reads the settled level and reports
+// it if it changed. A bouncy press costs one interrupt instead of dozens.
+
+// Called from the TIMER3 interrupt with the settled level
+typedef void (*hw_debounce_handler_t)(nrfx_gpiote_pin_t pin, uint32_t level);
+
+// Pin must already be set up as a high-accuracy GPIOTE input with its
+// event left disabled
+void hw_debounce_init(nrfx_gpiote_pin_t pin, uint32_t quiet_us, hw_debounce_handler_t handler);
+
+#endif // HW_DEBOUNCE_H__
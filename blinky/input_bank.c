@@ -0,0 +1,153 @@
+#include <nrfx_gpiote.h>
+#include <nrf_gpio.h>
+#include <app_error.h>
+#include "input_bank.h"
+#include "bottom_half.h"
+#include "debounce.h"
+#include "systime.h"
+#include "tickless.h"
+#include "runtime_stats.h"
+
+#if INPUT_BANK_ENABLED
+
+STATIC_ASSERT(INPUT_BANK_MAX_PINS <= 16);
+// every bank pin takes one of the driver's low-power slots, so does the
+// button in sense mode
+STATIC_ASSERT(INPUT_BANK_MAX_PINS + BUTTON_LOW_POWER_SENSE_ENABLED <=
+              NRFX_GPIOTE_CONFIG_NUM_OF_LOW_POWER_EVENTS);
+
+static uint32_t const *p_bank_pins;
+static uint32_t bank_count;
+static input_bank_handler_t bank_handler;
+
+// Levels last posted, one bit per input. Top half only.
+static uint32_t bank_levels;
+
+static debounce_t debounce[INPUT_BANK_MAX_PINS];
+static input_bank_stats_t stats;
+static tickless_timer_t settle_timer;
+
+// One bit per input from a single read of each port
+static uint32_t levels_snapshot(void)
+{
+    uint32_t port[2] = {nrf_gpio_port_in_read(NRF_P0), nrf_gpio_port_in_read(NRF_P1)};
+    uint32_t levels = 0;
+
+    for (uint32_t i = 0; i < bank_count; i++)
+    {
+        uint32_t pin = p_bank_pins[i];
+
+        if (port[pin >> 5] & (1UL << (pin & 31)))
+            levels |= 1UL << i;
+    }
+    return levels;
+}
+
+static uint32_t bank_level_read(uint32_t index)
+{
+    return nrf_gpio_pin_read(p_bank_pins[index]);
+}
+
+static void bank_settled(uint32_t index, uint32_t edge_us, uint32_t level)
+{
+    stats.accepted++;
+    stats.recovered++;
+    bank_handler(index, !level);
+}
+
+// Bottom half: catches edges that were hidden in a lockout
+static void bank_settle(uint32_t arg0, uint32_t arg1)
+{
+    uint32_t left_us = debounce_settle(debounce, bank_count, systime_us(),
+                                       bank_level_read, bank_settled);
+
+    if (left_us != DEBOUNCE_SETTLED)
+        tickless_timer_start(&settle_timer, (left_us + 999) / 1000, TICKLESS_CONFIG_SLACK_MS);
+}
+
+// Tickless timers run in thread mode, the debouncers in the bottom half
+static void settle_timer_handler(void *p_context)
+{
+    bottom_half_post(bank_settle, 0, 0);
+}
+
+// Bottom half: arg0 is changed << 16 | levels
+static void bank_process(uint32_t changes, uint32_t edge_us)
+{
+    uint32_t changed = changes >> 16;
+
+    for (uint32_t i = 0; changed != 0; i++, changed >>= 1)
+    {
+        uint32_t level = (changes >> i) & 1;
+
+        if (!(changed & 1))
+            continue;
+        if (!debounce_edge(&debounce[i], edge_us, level))
+        {
+            RUNTIME_STATS_INC(debounce_rejections);
+            continue;
+        }
+
+        stats.accepted++;
+        bank_handler(i, !level);
+    }
+
+    bank_settle(0, 0);
+}
+
+// Top half. The driver calls this for every bank pin whose sense fired in
+// this PORT interrupt; the first call reports all of them and the rest
+// find nothing new.
+static void bank_pin_handler(nrfx_gpiote_pin_t pin, nrf_gpiote_polarity_t action)
+{
+    TOP_HALF_BEGIN();
+    uint32_t levels = levels_snapshot();
+    uint32_t changed = levels ^ bank_levels;
+
+    if (changed == 0)
+        return;
+
+    bank_levels = levels;
+    RUNTIME_STATS_INC(input_events);
+    stats.interrupts++;
+    stats.changes += __builtin_popcount(changed);
+    bottom_half_post(bank_process, (changed << 16) | levels, systime_us());
+
+    TOP_HALF_END();
+}
+
+void input_bank_init(uint32_t const *p_pins, uint32_t count, input_bank_handler_t handler)
+{
+    // sense input, served by the PORT event
+    nrfx_gpiote_in_config_t config = NRFX_GPIOTE_CONFIG_IN_SENSE_TOGGLE(false);
+    config.pull = NRF_GPIO_PIN_PULLUP;
+
+    // past the driver's low-power slots nrfx_gpiote_in_init() fails
+    APP_ERROR_CHECK_BOOL(count <= INPUT_BANK_MAX_PINS);
+
+    p_bank_pins = p_pins;
+    bank_count = count;
+    bank_handler = handler;
+
+    if (!nrfx_gpiote_is_init())
+        APP_ERROR_CHECK(nrfx_gpiote_init());
+
+    for (uint32_t i = 0; i < count; i++)
+        APP_ERROR_CHECK(nrfx_gpiote_in_init(p_pins[i], &config, bank_pin_handler));
+
+    // pull-ups are on now
+    bank_levels = levels_snapshot();
+    for (uint32_t i = 0; i < count; i++)
+        debounce_init(&debounce[i], (bank_levels >> i) & 1);
+    tickless_timer_init(&settle_timer, settle_timer_handler, NULL);
+
+    for (uint32_t i = 0; i < count; i++)
+        nrfx_gpiote_in_event_enable(p_pins[i], true);
+}
+
+void input_bank_stats_get(input_bank_stats_t *p_stats)
+{
+    *p_stats = stats;
+}
+
+#endif // INPUT_BANK_ENABLED
@@ -0,0 +1,36 @@
+#ifndef INPUT_BANK_H__
+#define INPUT_BANK_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// A bank of extra buttons and switches on the shared GPIOTE PORT event.
+//
+// Every input is a low-power (sense) input, so the bank takes none of the
+// 8 GPIOTE channels and all of its pins share one interrupt. Each pin
+// still takes one of the driver's low-power slots, and
+// NRFX_GPIOTE_CONFIG_NUM_OF_LOW_POWER_EVENTS must cover INPUT_BANK_MAX_PINS
+// plus the button in sense mode. The top half snapshots both GPIO ports
+// once per interrupt, diffs them against the last reported state to get a
+// mask of the inputs that changed, and posts that with the levels as a
+// single bottom-half item. The bottom half debounces each input (see
+// debounce.h) and reports it.
+
+#define INPUT_BANK_MAX_PINS 16
+
+typedef struct
+{
+    uint32_t interrupts; // top halves that found a change
+    uint32_t changes;    // input changes posted
+    uint32_t accepted;   // changes that survived debouncing
+    uint32_t recovered;  // of those, found once a lockout was over
+} input_bank_stats_t;
+
+// Called from the bottom half; inputs are active low (pulled up)
+typedef void (*input_bank_handler_t)(uint32_t index, bool active);
+
+void input_bank_init(uint32_t const *p_pins, uint32_t count, input_bank_handler_t handler);
+
+void input_bank_stats_get(input_bank_stats_t *p_stats);
+
+#endif // INPUT_BANK_H__
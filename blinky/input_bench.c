@@ -0,0 +1,144 @@
+#include <nrfx_gpiote.h>
+#include <nrfx_timer.h>
+#include <nrfx_ppi.h>
+#include <nrf_rtc.h>
+#include <app_error.h>
+#include "input_bench.h"
+#include "irq_priority.h"
+#include "systime.h"
+
+#if INPUT_BENCH_ENABLED
+
+// Lead time between arming the RTC compare and the edge, ~1 ms, so the CPU
+// is asleep when it happens
+#define EDGE_DELAY_TICKS 33
+
+static const nrfx_timer_t timer = NRFX_TIMER_INSTANCE(4);
+
+static input_bench_result_t results[INPUT_BENCH_MODE_COUNT];
+static volatile bool edge_seen;
+static volatile uint32_t edge_latency_us;
+
+static void timer_handler(nrf_timer_event_t event_type, void *p_context)
+{
+}
+
+static void bench_in_handler(nrfx_gpiote_pin_t pin, nrf_gpiote_polarity_t action)
+{
+    edge_latency_us = nrfx_timer_capture(&timer, NRF_TIMER_CC_CHANNEL0);
+    nrfx_timer_disable(&timer);
+    nrfx_timer_clear(&timer);
+    edge_seen = true;
+}
+
+static void sleep_until_edge(void)
+{
+    while (!edge_seen)
+    {
+        __disable_irq();
+        if (!edge_seen)
+            __WFI();
+        __enable_irq();
+    }
+}
+
+static void sleep_for_ms(uint32_t ms)
+{
+    bool fired = false;
+
+    systime_alarm_set(systime_ticks() + SYSTIME_MS_TO_TICKS(ms));
+    while (!fired)
+    {
+        __disable_irq();
+        fired = systime_alarm_take();
+        if (!fired)
+            __WFI();
+        __enable_irq();
+    }
+}
+
+static void mode_run(input_bench_mode_t mode)
+{
+    input_bench_result_t *p_result = &results[mode];
+    nrfx_gpiote_in_config_t config = NRFX_GPIOTE_CONFIG_IN_SENSE_TOGGLE(mode == INPUT_BENCH_MODE_IN_EVENT);
+    uint64_t sum = 0;
+
+    config.pull = NRF_GPIO_PIN_NOPULL;
+    APP_ERROR_CHECK(nrfx_gpiote_in_init(INPUT_BENCH_IN_PIN, &config, bench_in_handler));
+    nrfx_gpiote_in_event_enable(INPUT_BENCH_IN_PIN, true);
+
+    p_result->min_us = UINT32_MAX;
+    for (uint32_t i = 0; i < INPUT_BENCH_SAMPLES; i++)
+    {
+        edge_seen = false;
+        nrf_rtc_event_clear(NRF_RTC1, NRF_RTC_EVENT_COMPARE_0);
+        nrf_rtc_cc_set(NRF_RTC1, 0, nrf_rtc_counter_get(NRF_RTC1) + EDGE_DELAY_TICKS);
+
+        sleep_until_edge();
+
+        if (edge_latency_us < p_result->min_us)
+            p_result->min_us = edge_latency_us;
+        if (edge_latency_us > p_result->max_us)
+            p_result->max_us = edge_latency_us;
+        sum += edge_latency_us;
+        p_result->samples++;
+    }
+    p_result->avg_us = (uint32_t)(sum / p_result->samples);
+
+    // standby window: input armed, nothing else running
+    p_result->idle_start_ms = systime_ms();
+    sleep_for_ms(INPUT_BENCH_IDLE_MS);
+    p_result->idle_end_ms = systime_ms();
+
+    nrfx_gpiote_in_uninit(INPUT_BENCH_IN_PIN);
+}
+
+void input_bench_run(void)
+{
+    nrf_ppi_channel_t channel;
+    nrfx_gpiote_out_config_t out_config = NRFX_GPIOTE_CONFIG_OUT_TASK_TOGGLE(false);
+    nrfx_timer_config_t timer_config = {
+        .frequency = NRF_TIMER_FREQ_1MHz,
+        .mode = NRF_TIMER_MODE_TIMER,
+        .bit_width = NRF_TIMER_BIT_WIDTH_32,
+        .interrupt_priority = IRQ_PRIORITY_LOW,
+        .p_context = NULL};
+
+    if (!nrfx_gpiote_is_init())
+        APP_ERROR_CHECK(nrfx_gpiote_init());
+
+    APP_ERROR_CHECK(nrfx_gpiote_out_init(INPUT_BENCH_OUT_PIN, &out_config));
+    nrfx_gpiote_out_task_enable(INPUT_BENCH_OUT_PIN);
+    APP_ERROR_CHECK(nrfx_timer_init(&timer, &timer_config, timer_handler));
+
+    // RTC1 is free-running at 32 kHz with only the compare event routed to PPI
+    nrf_rtc_prescaler_set(NRF_RTC1, 0);
+    nrf_rtc_event_enable(NRF_RTC1, NRF_RTC_INT_COMPARE0_MASK);
+    nrf_rtc_task_trigger(NRF_RTC1, NRF_RTC_TASK_START);
+
+    // the edge and the start of the stopwatch come from the same event
+    APP_ERROR_CHECK(nrfx_ppi_channel_alloc(&channel));
+    APP_ERROR_CHECK(nrfx_ppi_channel_assign(channel,
+                                            nrf_rtc_event_address_get(NRF_RTC1, NRF_RTC_EVENT_COMPARE_0),
+                                            nrfx_gpiote_out_task_addr_get(INPUT_BENCH_OUT_PIN)));
+    APP_ERROR_CHECK(nrfx_ppi_channel_fork_assign(channel,
+                                                 nrfx_timer_task_address_get(&timer, NRF_TIMER_TASK_START)));
+    APP_ERROR_CHECK(nrfx_ppi_channel_enable(channel));
+
+    for (int mode = 0; mode < INPUT_BENCH_MODE_COUNT; mode++)
+        mode_run((input_bench_mode_t)mode);
+
+    nrfx_ppi_channel_disable(channel);
+    nrfx_ppi_channel_free(channel);
+    nrf_rtc_task_trigger(NRF_RTC1, NRF_RTC_TASK_STOP);
+    nrf_rtc_event_disable(NRF_RTC1, NRF_RTC_INT_COMPARE0_MASK);
+    nrfx_timer_uninit(&timer);
+    nrfx_gpiote_out_uninit(INPUT_BENCH_OUT_PIN);
+}
+
+input_bench_result_t const *input_bench_results(void)
+{
+    return results;
+}
+
+#endif // INPUT_BENCH_ENABLED
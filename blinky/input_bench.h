@@ -0,0 +1,41 @@
+#ifndef INPUT_BENCH_H__
+#define INPUT_BENCH_H__
+
+#include <stdint.h>
+
+// Benchmark of the two GPIOTE input modes: high-accuracy IN event and
+// low-power PORT/DETECT event with sense flipping.
+//
+// Needs INPUT_BENCH_OUT_PIN wired to INPUT_BENCH_IN_PIN. For each mode an
+// RTC1 compare toggles the OUT pin through PPI and starts TIMER4 at the same
+// instant while the CPU sleeps with HFCLK off; the input handler captures
+// TIMER4, giving edge-to-handler wakeup latency in microseconds.
+//
+// Standby current cannot be measured from firmware. After the latency run
+// each mode is left armed with the CPU asleep for INPUT_BENCH_IDLE_MS, in
+// the order of the results array, so it can be read on a power analyzer.
+
+typedef enum
+{
+    INPUT_BENCH_MODE_IN_EVENT,
+    INPUT_BENCH_MODE_PORT_EVENT,
+    INPUT_BENCH_MODE_COUNT
+} input_bench_mode_t;
+
+typedef struct
+{
+    uint32_t samples;
+    uint32_t min_us;
+    uint32_t max_us;
+    uint32_t avg_us;
+    uint32_t idle_start_ms; // standby window, systime
+    uint32_t idle_end_ms;
+} input_bench_result_t;
+
+// Runs both modes; call after systime_init() and before anything that
+// keeps HFCLK running. Takes about 2 * INPUT_BENCH_IDLE_MS.
+void input_bench_run(void);
+
+input_bench_result_t const *input_bench_results(void);
+
+#endif // INPUT_BENCH_H__
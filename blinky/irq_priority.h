@@ -0,0 +1,34 @@
+#ifndef IRQ_PRIORITY_H__
+#define IRQ_PRIORITY_H__
+
+#include <app_util.h>
+#include <sdk_config.h>
+
+// Interrupt priority map (0 is highest and left free).
+//
+// Top halves run at the highest level and only capture state (pin level,
+// timestamps, counters) before posting the rest to the bottom half, so
+// nothing added at the lower levels can delay input capture.
+//
+//   1  WATCHDOG     WDT timeout, records the overdue task before the reset
+//   2  INPUT        GPIOTE (button edges), TIMER3 debounce, QDEC
+//   3  TIMEBASE     RTC2 system time overflow and tickless alarm
+//   5  OUTPUT       TIMER2 frame clock, PWM0
+//   6  BOTTOM_HALF  SWI1_EGU1, deferred input processing
+//   7  LOW          SAADC light sensor, TEMP, anything that is neither time
+//                   critical nor input
+//
+// Thread mode (main loop, coroutines, tickless timers) runs below all of
+// them.
+
+#define IRQ_PRIORITY_WATCHDOG 1
+#define IRQ_PRIORITY_INPUT 2
+#define IRQ_PRIORITY_TIMEBASE 3
+#define IRQ_PRIORITY_OUTPUT 5
+#define IRQ_PRIORITY_BOTTOM_HALF 6
+#define IRQ_PRIORITY_LOW 7
+
+// nrfx_gpiote only takes its priority from sdk_config.h
+STATIC_ASSERT(NRFX_GPIOTE_CONFIG_IRQ_PRIORITY == IRQ_PRIORITY_INPUT);
+
+#endif // IRQ_PRIORITY_H__
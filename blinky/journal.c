@@ -0,0 +1,79 @@
+#include <nrf_atomic.h>
+#include <nrf_power.h>
+#include <app_util.h>
+#include <sdk_config.h>
+#include "journal.h"
+#include "systime.h"
+
+#define JOURNAL_MAGIC 0x4A524E4CUL // "JRNL"
+#define JOURNAL_MASK (JOURNAL_CONFIG_SIZE - 1)
+
+STATIC_ASSERT((JOURNAL_CONFIG_SIZE & JOURNAL_MASK) == 0);
+
+typedef struct
+{
+    uint32_t magic;
+    uint32_t size;  // JOURNAL_CONFIG_SIZE the entries were written with
+    uint32_t boots;
+    nrf_atomic_u32_t head; // entries ever appended; head & JOURNAL_MASK is the next slot
+    journal_entry_t entries[JOURNAL_CONFIG_SIZE];
+} journal_t;
+
+static journal_t journal __attribute__((section(".noinit")));
+
+static uint32_t reset_reason;
+
+void journal_init(void)
+{
+    reset_reason = nrf_power_resetreas_get();
+    nrf_power_resetreas_clear(reset_reason);
+
+    // power-on or a different layout: the RAM holds garbage
+    if (journal.magic != JOURNAL_MAGIC || journal.size != JOURNAL_CONFIG_SIZE)
+    {
+        journal.size = JOURNAL_CONFIG_SIZE;
+        journal.boots = 0;
+        journal.head = 0;
+        journal.magic = JOURNAL_MAGIC;
+    }
+
+    journal.boots++;
+    journal_append(JOURNAL_BOOT, (uint8_t)journal.boots,
+                   (uint16_t)((reset_reason & 0xFF) | ((reset_reason >> 8) & 0xFF00)));
+}
+
+void journal_append(journal_type_t type, uint8_t code, uint16_t arg)
+{
+    // claiming the slot is the only shared step; a nested append takes the next one
+    uint32_t slot = nrf_atomic_u32_fetch_add(&journal.head, 1) & JOURNAL_MASK;
+    journal_entry_t *p_entry = &journal.entries[slot];
+
+    p_entry->time_ms = systime_ms();
+    p_entry->type = (uint8_t)type;
+    p_entry->code = code;
+    p_entry->arg = arg;
+}
+
+void journal_dump(journal_sink_t sink)
+{
+    uint32_t head = journal.head;
+    uint32_t count = (head < JOURNAL_CONFIG_SIZE) ? head : JOURNAL_CONFIG_SIZE;
+
+    for (uint32_t seq = head - count; seq != head; seq++)
+    {
+        journal_entry_t entry = journal.entries[seq & JOURNAL_MASK];
+        sink(seq, &entry);
+    }
+}
+
+uint32_t journal_count(void)
+{
+    uint32_t head = journal.head;
+
+    return (head < JOURNAL_CONFIG_SIZE) ? head : JOURNAL_CONFIG_SIZE;
+}
+
+uint32_t journal_reset_reason(void)
+{
+    return reset_reason;
+}
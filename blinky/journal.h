@@ -0,0 +1,47 @@
+#ifndef JOURNAL_H__
+#define JOURNAL_H__
+
+#include <stdint.h>
+
+// Input event journal in RAM that is not cleared at startup (.noinit), so
+// the last JOURNAL_CONFIG_SIZE events survive a soft reset, watchdog reset
+// or crash. A power cycle loses it; the magic word tells the two apart.
+// Timestamps are systime milliseconds and restart at every boot, which is
+// marked with a JOURNAL_BOOT entry.
+
+typedef enum
+{
+    JOURNAL_BOOT,    // code: boot count, arg: RESETREAS (bits 16+ moved to 8+)
+    JOURNAL_EDGE,    // code: level, arg: pin
+    JOURNAL_GESTURE, // code: gesture_type_t
+    JOURNAL_ENCODER, // arg: detents as int16_t
+    JOURNAL_BANK     // code: active, arg: input bank index
+} journal_type_t;
+
+typedef struct
+{
+    uint32_t time_ms;
+    uint8_t type;
+    uint8_t code;
+    uint16_t arg;
+} journal_entry_t;
+
+typedef void (*journal_sink_t)(uint32_t seq, journal_entry_t const *p_entry);
+
+// Validates the retained journal (clearing it after a power cycle) and
+// appends the boot marker. Reads and clears RESETREAS.
+void journal_init(void);
+
+// O(1), lock-free, safe from any interrupt priority
+void journal_append(journal_type_t type, uint8_t code, uint16_t arg);
+
+// Calls sink for every retained entry, oldest first
+void journal_dump(journal_sink_t sink);
+
+// Entries retained, at most JOURNAL_CONFIG_SIZE
+uint32_t journal_count(void);
+
+// RESETREAS as found by journal_init()
+uint32_t journal_reset_reason(void);
+
+#endif // JOURNAL_H__
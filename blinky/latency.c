@@ -0,0 +1,102 @@
+#include <nrfx_ppi.h>
+#include <app_error.h>
+#include "latency.h"
+#include "edge_capture.h"
+
+#if LATENCY_ENABLED
+
+#if !EDGE_CAPTURE_ENABLED
+#error "LATENCY_ENABLED needs EDGE_CAPTURE_ENABLED for the edge timestamps"
+#endif
+
+// the last bucket is open ended, the ones before it must reach past the
+// slowest gestures
+STATIC_ASSERT(LATENCY_CONFIG_BUCKET_MS * (LATENCY_BUCKETS - 1) > GESTURE_CONFIG_HOLD_MS);
+STATIC_ASSERT(LATENCY_CONFIG_BUCKET_MS * (LATENCY_BUCKETS - 1) > GESTURE_CONFIG_CLICK_GAP_MS);
+
+static nrf_ppi_channel_t channel;
+static nrf_ppi_channel_group_t group;
+static uint8_t slot;
+
+static volatile bool input_pending = false;
+static volatile uint32_t input_us;
+
+static bool armed = false;
+static uint32_t armed_edge_us;
+
+static latency_stats_t stats = {.min_us = UINT32_MAX};
+
+static void sample_add(uint32_t latency_us)
+{
+    uint32_t bucket = latency_us / (LATENCY_CONFIG_BUCKET_MS * 1000);
+
+    if (bucket >= LATENCY_BUCKETS)
+        bucket = LATENCY_BUCKETS - 1;
+    stats.histogram[bucket]++;
+
+    stats.samples++;
+    stats.total_us += latency_us;
+    if (latency_us < stats.min_us)
+        stats.min_us = latency_us;
+    if (latency_us > stats.max_us)
+        stats.max_us = latency_us;
+}
+
+void latency_init(uint32_t period_end_event_addr)
+{
+    uint32_t capture_task = edge_capture_slot_alloc(&slot);
+
+    APP_ERROR_CHECK(nrfx_ppi_channel_alloc(&channel));
+    APP_ERROR_CHECK(nrfx_ppi_group_alloc(&group));
+    APP_ERROR_CHECK(nrfx_ppi_channel_assign(channel, period_end_event_addr, capture_task));
+    // one shot: the same event turns the channel off again
+    APP_ERROR_CHECK(nrfx_ppi_channel_fork_assign(channel, nrfx_ppi_task_addr_group_disable_get(group)));
+    APP_ERROR_CHECK(nrfx_ppi_channel_include_in_group(channel, group));
+    // left disabled until armed
+}
+
+void latency_input(uint32_t edge_us)
+{
+    input_us = edge_us;
+    input_pending = true;
+}
+
+void latency_cancel(void)
+{
+    input_pending = false;
+}
+
+void latency_output(void)
+{
+    if (!input_pending || armed)
+        return;
+
+    input_pending = false;
+
+    // a change long after the input was not caused by it
+    if (edge_capture_now_us() - input_us > LATENCY_CONFIG_TIMEOUT_MS * 1000UL)
+    {
+        stats.expired++;
+        return;
+    }
+
+    armed_edge_us = input_us;
+    armed = true;
+    APP_ERROR_CHECK(nrfx_ppi_group_enable(group));
+}
+
+void latency_collect(void)
+{
+    if (!armed || nrf_ppi_channel_enable_get(channel) != NRF_PPI_CHANNEL_DISABLED)
+        return;
+
+    armed = false;
+    sample_add(edge_capture_slot_get_us(slot) - armed_edge_us);
+}
+
+void latency_stats_get(latency_stats_t *p_stats)
+{
+    *p_stats = stats;
+}
+
+#endif // LATENCY_ENABLED
@@ -0,0 +1,48 @@
+#ifndef LATENCY_H__
+#define LATENCY_H__
+
+#include <stdint.h>
+
+// Button-to-light latency measurement, needs EDGE_CAPTURE_ENABLED.
+//
+// The button edge is timestamped on TIMER1 by edge capture. When the
+// first duty change after that input is written, a PPI channel in its own
+// group is armed: the next PWM PERIODEND captures TIMER1 into a spare
+// slot and disables the group through the channel's fork, so exactly one
+// period end is caught with no interrupt. That is the start of the first
+// period playing the new duty (within one PWM period). The main loop
+// collects the capture and adds edge-to-light to a histogram.
+
+// At 50 ms per bucket, covers a hold starting GESTURE_CONFIG_HOLD_MS after
+// its press, the longest wait from an edge to a gesture
+#define LATENCY_BUCKETS 32
+
+typedef struct
+{
+    uint32_t samples;
+    uint32_t expired; // inputs that produced no change in time
+    uint32_t min_us;
+    uint32_t max_us;
+    uint64_t total_us;
+    uint32_t histogram[LATENCY_BUCKETS]; // LATENCY_CONFIG_BUCKET_MS wide, last is open ended
+} latency_stats_t;
+
+void latency_init(uint32_t period_end_event_addr);
+
+// An input whose effect should show up on the LED; edge_us is on the edge
+// capture clock. Safe from interrupt context.
+void latency_input(uint32_t edge_us);
+
+// The last input turned out to change nothing, drops it. Safe from
+// interrupt context.
+void latency_cancel(void);
+
+// A new duty was just written; arms the capture if an input is waiting
+void latency_output(void);
+
+// Picks up a finished capture, call from the main loop
+void latency_collect(void);
+
+void latency_stats_get(latency_stats_t *p_stats);
+
+#endif // LATENCY_H__
@@ -2,9 +2,39 @@
 #include <nrfx_gpiote.h>
 #include <nrf_gpio.h>
 #include <nrf_delay.h>
+#include <app_error.h>
+#define NRF_LOG_LEVEL APP_CONFIG_LOG_LEVEL
+#include <nrf_log.h>
+#include <nrf_log_ctrl.h>
+#include <nrf_log_default_backends.h>
 #include <stdint.h>
 #include <stdbool.h>
-#include <nrfx_systick.h>
+#include "systime.h"
+#include "edge_capture.h"
+#include "frame_clock.h"
+#include "bottom_half.h"
+#include "irq_priority.h"
+#include "gesture.h"
+#include "hw_debounce.h"
+#include "input_bench.h"
+#include "brightness.h"
+#include "encoder.h"
+#include "journal.h"
+#include "debounce.h"
+#include "ambient.h"
+#include "thermal.h"
+#include "input_bank.h"
+#include "profile.h"
+#include "trace.h"
+#include "cpu_load.h"
+#include "latency.h"
+#include "ram_usage.h"
+#include "crash.h"
+#include "energy.h"
+#include "watchdog.h"
+#include "runtime_stats.h"
+#include "coro.h"
+#include "tickless.h"
 
 #define BUTTON NRF_GPIO_PIN_MAP(1, 6)
 #define LED_1 NRF_GPIO_PIN_MAP(0, 6)
@@ -12,6 +42,25 @@
 #define LED_G NRF_GPIO_PIN_MAP(0, 9)
 #define LED_B NRF_GPIO_PIN_MAP(0, 12)
 #define LED_INVALID (uint32_t)(-1)
+#define ENCODER_A NRF_GPIO_PIN_MAP(0, 24)
+#define ENCODER_B NRF_GPIO_PIN_MAP(1, 0)
+
+#if INPUT_BANK_ENABLED
+// Extra buttons and switches on the custom boards
+static const uint32_t bank_pins[] = {
+    NRF_GPIO_PIN_MAP(0, 17),
+    NRF_GPIO_PIN_MAP(0, 20),
+    NRF_GPIO_PIN_MAP(0, 22),
+    NRF_GPIO_PIN_MAP(1, 10)};
+#define BANK_PIN_COUNT (sizeof(bank_pins) / sizeof(bank_pins[0]))
+#endif
+
+#if BUTTON_LOW_POWER_SENSE_ENABLED && (BUTTON_HW_DEBOUNCE_ENABLED || EDGE_CAPTURE_ENABLED)
+#error "PORT sense input has no GPIOTE IN event for PPI, disable BUTTON_HW_DEBOUNCE_ENABLED and EDGE_CAPTURE_ENABLED"
+#endif
+
+// 1 MHz PWM clock, so one PWM period is PWM_TOP us
+#define PWM_TOP 1000
 
 // sequence
 uint32_t led_seq[] = {
@@ -25,7 +74,10 @@ static uint32_t led_index = 0;
 static nrfx_pwm_t pwm0 = NRFX_PWM_INSTANCE(0);
 
 static uint32_t prev_led = LED_INVALID;
+// LED the PWM is driving
+static uint32_t pwm_pin = LED_INVALID;
 
+static uint16_t pwm_duty = 0; // as requested, before brightness scaling
 static uint16_t pwm_value = 0;
 static nrf_pwm_sequence_t pwm_seq = {
     .values.p_common = &pwm_value,
@@ -33,6 +85,23 @@ static nrf_pwm_sequence_t pwm_seq = {
     .repeats = 0,
     .end_delay = 0};
 
+#if ENERGY_ENABLED
+static energy_led_t energy_led(uint32_t pin)
+{
+    switch (pin)
+    {
+    case LED_R:
+        return ENERGY_LED_R;
+    case LED_G:
+        return ENERGY_LED_G;
+    case LED_B:
+        return ENERGY_LED_B;
+    default:
+        return ENERGY_LED_1;
+    }
+}
+#endif
+
 void pwm_init(uint32_t pin)
 {
     nrfx_pwm_config_t config = {
@@ -40,10 +109,10 @@ void pwm_init(uint32_t pin)
                         NRFX_PWM_PIN_NOT_USED,
                         NRFX_PWM_PIN_NOT_USED,
                         NRFX_PWM_PIN_NOT_USED},
-        .irq_priority = NRFX_PWM_DEFAULT_CONFIG_IRQ_PRIORITY,
+        .irq_priority = IRQ_PRIORITY_OUTPUT,
         .base_clock = NRF_PWM_CLK_1MHz,
         .count_mode = NRF_PWM_MODE_UP,
-        .top_value = 1000,
+        .top_value = PWM_TOP,
         .load_mode = NRF_PWM_LOAD_COMMON,
         .step_mode = NRF_PWM_STEP_AUTO};
 
@@ -53,6 +122,12 @@ void pwm_init(uint32_t pin)
 
     nrfx_pwm_init(&pwm0, &config, NULL);
     nrfx_pwm_simple_playback(&pwm0, &pwm_seq, 1, NRFX_PWM_FLAG_LOOP);
+    pwm_pin = pin;
+#if ENERGY_ENABLED
+    energy_pwm_set(true);
+    energy_hf_request(ENERGY_HF_PWM, true);
+    energy_led_set(energy_led(pin), pwm_value * 1000 / PWM_TOP);
+#endif
 }
 
 void pwm_deinit_safe(void)
@@ -61,6 +136,13 @@ void pwm_deinit_safe(void)
     nrfx_pwm_stop(&pwm0, false);
 #endif
     nrfx_pwm_uninit(&pwm0);
+#if ENERGY_ENABLED
+    energy_pwm_set(false);
+    energy_hf_request(ENERGY_HF_PWM, false);
+    if (pwm_pin != LED_INVALID)
+        energy_led_set(energy_led(pwm_pin), 0);
+#endif
+    pwm_pin = LED_INVALID;
     if (prev_led != LED_INVALID)
     {
         nrf_gpio_cfg_output(prev_led);
@@ -68,15 +150,49 @@ void pwm_deinit_safe(void)
     }
 }
 
+// Brightness scaling, then the thermal limit
+static uint16_t pwm_output(uint16_t duty)
+{
+    uint16_t value = brightness_apply(duty);
+#if THERMAL_ENABLED
+    uint16_t max = thermal_max_duty();
+
+    if (value > max)
+        value = max;
+#endif
+    return value;
+}
+
 void pwm_set_duty(uint16_t duty)
 {
     if (duty > 1000)
         duty = 1000;
-    pwm_value = duty;
+    pwm_duty = duty;
+
+    uint16_t value = pwm_output(duty);
+    if (value == pwm_value)
+        return;
+    pwm_value = value;
+#if ENERGY_ENABLED
+    if (pwm_pin != LED_INVALID)
+        energy_led_set(energy_led(pwm_pin), value * 1000 / PWM_TOP);
+#endif
+#if LATENCY_ENABLED
+    latency_output();
+#endif
+}
+
+// Re-applies the current duty after the brightness or the limit changed
+static void pwm_refresh(void)
+{
+    if (pwm_value != pwm_output(pwm_duty))
+        pwm_set_duty(pwm_duty);
 }
 
 void pwm_switch_led(uint32_t pin)
 {
+    PROFILE_BEGIN(pwm_switch_led);
+
     // Stopping pwm, not clearing the current pin
     pwm_deinit_safe();
 
@@ -88,45 +204,419 @@ void pwm_switch_led(uint32_t pin)
     }
 
     pwm_init(pin);
+    RUNTIME_STATS_INC(pwm_restarts);
 
     prev_led = pin;
+
+    PROFILE_END(pwm_switch_led);
 }
 
 volatile bool blinking = false;
 
-static nrfx_systick_state_t last_click_state;
-static bool last_click_valid = false;
+#if INPUT_BENCH_ENABLED
+static void input_bench_print(void)
+{
+    input_bench_result_t const *p_results = input_bench_results();
 
-static nrfx_systick_state_t last_debounce;
-#define DEBOUNCE_MKS (70 * 1000U)
-#define DOUBLE_CLICK_MKS (400 * 1000U)
+    for (uint32_t mode = 0; mode < INPUT_BENCH_MODE_COUNT; mode++)
+    {
+        NRF_LOG_INFO("%s event: %u edges, latency min %u avg %u max %u us",
+                     (mode == INPUT_BENCH_MODE_IN_EVENT) ? "IN" : "PORT", p_results[mode].samples,
+                     p_results[mode].min_us, p_results[mode].avg_us, p_results[mode].max_us);
+        NRF_LOG_INFO("  idle window %u..%u ms", p_results[mode].idle_start_ms, p_results[mode].idle_end_ms);
+    }
+}
+#endif
 
-void button_handler(nrfx_gpiote_pin_t pin, nrf_gpiote_polarity_t action)
+#define FADE_STEP_DEFAULT 10
+#define FADE_STEP_MAX 50
+
+// Duty change per frame, i.e. the animation speed
+static volatile uint16_t fade_step = FADE_STEP_DEFAULT;
+
+#if NRF_LOG_ENABLED
+static uint32_t log_timestamp(void)
+{
+    return (uint32_t)systime_ticks();
+}
+#endif
+
+static void crash_print(void)
+{
+    crash_record_t crash;
+
+    if (!crash_get(&crash))
+        return;
+
+    NRF_LOG_ERROR("crash type %u at %u ms, ipsr %u", crash.type, crash.time_ms, crash.ipsr);
+    NRF_LOG_ERROR("pc 0x%08x lr 0x%08x sp 0x%08x xpsr 0x%08x", crash.pc, crash.lr, crash.sp, crash.xpsr);
+    NRF_LOG_ERROR("r0 0x%08x r1 0x%08x r2 0x%08x r3 0x%08x r12 0x%08x",
+                  crash.r0, crash.r1, crash.r2, crash.r3, crash.r12);
+    NRF_LOG_ERROR("cfsr 0x%08x hfsr 0x%08x mmfar 0x%08x bfar 0x%08x",
+                  crash.cfsr, crash.hfsr, crash.mmfar, crash.bfar);
+    if (crash.type == CRASH_WATCHDOG)
+        NRF_LOG_ERROR("watchdog: task %u overdue by %u ms", crash.fault_id, crash.error_code);
+    // the record is on this stack, the deferred logger needs its own copy
+    if (crash.file[0] != '\0')
+        NRF_LOG_ERROR("error 0x%x at %s:%u", crash.error_code, NRF_LOG_PUSH(crash.file), crash.line);
+    for (uint32_t i = 0; i < crash.trace_count; i++)
+    {
+        NRF_LOG_ERROR("trace %u: id %u kind %u ctx %u 0x%08x 0x%08x", crash.trace[i].timestamp,
+                      crash.trace[i].id, crash.trace[i].kind, crash.trace[i].context,
+                      crash.trace[i].arg0, crash.trace[i].arg1);
+    }
+}
+
+static void journal_print(uint32_t seq, journal_entry_t const *p_entry)
+{
+    NRF_LOG_INFO("journal %u: %u ms type %u code %u arg 0x%04x",
+                 seq, p_entry->time_ms, p_entry->type, p_entry->code, p_entry->arg);
+}
+
+static void cpu_load_print(void)
+{
+    cpu_load_t load;
+
+    cpu_load_get(&load);
+    NRF_LOG_INFO("cpu load %u permille, avg %u, peak %u",
+                 load.last_permille, load.avg_permille, load.peak_permille);
+    for (uint32_t irq = 0; irq < CPU_LOAD_IRQ_COUNT; irq++)
+    {
+        if (load.wakeups_by_irq[irq])
+            NRF_LOG_INFO("wakeups by IRQ %u: %u", irq, load.wakeups_by_irq[irq]);
+    }
+}
+
+static void ram_usage_print(void)
 {
-    nrfx_systick_state_t now;
-    nrfx_systick_get(&now);
+    ram_usage_t ram;
+    bottom_half_stats_t bottom_half;
+    tickless_stats_t tickless;
+
+    ram_usage_get(&ram);
+    NRF_LOG_INFO("stack peak %u of %u bytes, main %u, isr at least %u",
+                 ram.stack_peak, ram.stack_size, ram.stack_thread, ram.stack_isr_peak);
+    NRF_LOG_INFO("heap peak %u of %u bytes", ram.heap_peak, ram.heap_size);
+
+    bottom_half_stats_get(&bottom_half);
+    tickless_stats_get(&tickless);
+    NRF_LOG_INFO("bottom half queue peak %u of %u", bottom_half.queue_peak, BOTTOM_HALF_CONFIG_QUEUE_SIZE);
+    NRF_LOG_INFO("tickless windows peak %u of %u", tickless.windows_peak, TICKLESS_CONFIG_MAX_WINDOWS);
+    NRF_LOG_INFO("journal %u of %u, trace %u of %u",
+                 journal_count(), JOURNAL_CONFIG_SIZE, trace_count(), TRACE_CONFIG_SIZE);
+#if NRF_LOG_ENABLED
+    // the logger keeps no high-water mark, only its reservation can be shown
+    NRF_LOG_INFO("log buffer %u bytes, message pool %u x %u bytes",
+                 NRF_LOG_BUFSIZE, NRF_LOG_MSGPOOL_ELEMENT_COUNT, NRF_LOG_MSGPOOL_ELEMENT_SIZE);
+#endif
+}
+
+static void runtime_stats_print(void)
+{
+    runtime_stats_t stats;
+
+    runtime_stats_snapshot(&stats);
+    NRF_LOG_INFO("frames %u rendered %u dropped %u, pwm restarts %u",
+                 stats.frames, stats.frames_rendered, stats.frames_dropped, stats.pwm_restarts);
+    NRF_LOG_INFO("inputs %u bounces %u gestures %u, bottom half %u dropped %u",
+                 stats.input_events, stats.debounce_rejections, stats.gestures,
+                 stats.bottom_half_posted, stats.bottom_half_dropped);
+    NRF_LOG_INFO("sleeps %u rtc %u, max cycles top half %u bottom half %u",
+                 stats.sleeps, stats.rtc_wakeups, stats.top_half_max_cycles, stats.bottom_half_max_cycles);
+}
+
+#if ENERGY_ENABLED
+static void energy_print(void)
+{
+    energy_t energy;
+
+    energy_get(&energy);
+    NRF_LOG_INFO("energy %u uAh in %u s, avg %u uA", energy.charge_uah,
+                 (uint32_t)(energy.elapsed_ticks / SYSTIME_TICK_HZ), energy.total_avg_ua);
+    NRF_LOG_INFO("avg uA: sleep %u cpu %u hfclk %u pwm %u qdec %u led %u",
+                 energy.avg_ua[ENERGY_PART_SLEEP], energy.avg_ua[ENERGY_PART_CPU],
+                 energy.avg_ua[ENERGY_PART_HFCLK], energy.avg_ua[ENERGY_PART_PWM],
+                 energy.avg_ua[ENERGY_PART_QDEC], energy.avg_ua[ENERGY_PART_LED]);
+}
+#endif
+
+#if LATENCY_ENABLED
+static void latency_print(void)
+{
+    latency_stats_t latency;
 
-    if (!nrfx_systick_test(&last_debounce, DEBOUNCE_MKS))
+    latency_stats_get(&latency);
+    if (latency.samples == 0)
         return;
 
-    last_debounce = now;
+    NRF_LOG_INFO("button to light: n %u min %u mean %u max %u us", latency.samples, latency.min_us,
+                 (uint32_t)(latency.total_us / latency.samples), latency.max_us);
+    for (uint32_t i = 0; i < LATENCY_BUCKETS; i++)
+    {
+        if (latency.histogram[i])
+            NRF_LOG_INFO("  %u ms: %u", i * LATENCY_CONFIG_BUCKET_MS, latency.histogram[i]);
+    }
+}
+#endif
+
+#if PROFILE_ENABLED
+static void profile_print(void)
+{
+    for (profile_site_t const *p_site = profile_sites(); p_site != NULL; p_site = p_site->p_next)
+    {
+        NRF_LOG_INFO("%s: n %u min %u mean %u max %u cycles", p_site->name, p_site->count,
+                     p_site->min_cycles, profile_mean_cycles(p_site), p_site->max_cycles);
+    }
+}
+#endif
+
+// What the encoder controls, switched with a single click
+static volatile enum {
+    KNOB_BRIGHTNESS,
+    KNOB_SPEED
+} knob_mode = KNOB_BRIGHTNESS;
+
+// Maps gestures to commands, runs in the bottom half
+static void gesture_handler(gesture_event_t const *p_event)
+{
+    journal_append(JOURNAL_GESTURE, (uint8_t)p_event->type, 0);
+    TRACE_INSTANT(TRACE_ID_GESTURE, p_event->type, 0);
+    RUNTIME_STATS_INC(gestures);
+
+    // cost of a deferred log call from interrupt context
+    PROFILE_BEGIN(log_call);
+    NRF_LOG_INFO("gesture %u", p_event->type);
+    PROFILE_END(log_call);
 
-    if (last_click_valid && !nrfx_systick_test(&last_click_state, DOUBLE_CLICK_MKS))
+    switch (p_event->type)
+    {
+    case GESTURE_SINGLE_CLICK:
+        knob_mode = (knob_mode == KNOB_BRIGHTNESS) ? KNOB_SPEED : KNOB_BRIGHTNESS;
+        break;
+
+    case GESTURE_TRIPLE_CLICK:
+        journal_dump(journal_print);
+        cpu_load_print();
+        ram_usage_print();
+        runtime_stats_print();
+#if ENERGY_ENABLED
+        energy_print();
+#endif
+#if LATENCY_ENABLED
+        latency_print();
+#endif
+#if PROFILE_ENABLED
+        profile_print();
+#endif
+        break;
+
+    case GESTURE_DOUBLE_CLICK:
         blinking = !blinking;
+#if LATENCY_ENABLED
+        // pausing leaves the duty where it is, nothing to time
+        if (blinking)
+            latency_input(p_event->edge_us);
+        else
+            latency_cancel();
+#endif
+        tickless_notify();
+        break;
+
+    case GESTURE_HOLD_START:
+#if LATENCY_ENABLED
+        latency_input(p_event->edge_us);
+#endif
+        brightness_ramp_start();
+        tickless_notify();
+        break;
 
-    last_click_state = now;
-    last_click_valid = true;
+    case GESTURE_HOLD_END:
+        brightness_ramp_stop();
+        break;
+
+    default:
+        break;
+    }
 }
 
+#if ENCODER_ENABLED
+// Runs in the bottom half, like the gesture handler
+static void encoder_handler(int32_t detents)
+{
+    journal_append(JOURNAL_ENCODER, 0, (uint16_t)(int16_t)detents);
+
+    if (knob_mode == KNOB_BRIGHTNESS)
+    {
+        brightness_adjust(detents * ENCODER_CONFIG_BRIGHTNESS_STEP);
+    }
+    else
+    {
+        int32_t step = (int32_t)fade_step + detents;
+
+        if (step < 1)
+            step = 1;
+        if (step > FADE_STEP_MAX)
+            step = FADE_STEP_MAX;
+        fade_step = (uint16_t)step;
+    }
+    tickless_notify();
+}
+#endif
+
+#if INPUT_BANK_ENABLED
+// Runs in the bottom half; the bank inputs have no function yet beyond
+// being recorded
+static void bank_handler(uint32_t index, bool active)
+{
+    journal_append(JOURNAL_BANK, active, (uint16_t)index);
+}
+#endif
+
+// Bottom half: a clean edge goes to the gesture recognizer
+static void button_edge_accept(uint32_t edge_us, uint32_t level)
+{
+    // pulled up, pressed pulls the pin low
+    gesture_input(level == 0, edge_us);
+}
+
+#if BUTTON_HW_DEBOUNCE_ENABLED
+
+// Top half, TIMER3 interrupt: the level has already settled
+static void button_debounced_handler(nrfx_gpiote_pin_t pin, uint32_t level)
+{
+    PROFILE_BEGIN(button_debounced_handler);
+#if EDGE_CAPTURE_ENABLED
+    // last edge of the bounce burst
+    uint32_t edge_us = edge_capture_get_us(pin);
+#else
+    uint32_t edge_us = systime_us() - BUTTON_HW_DEBOUNCE_QUIET_US;
+#endif
+#if JOURNAL_CONFIG_EDGES_ENABLED
+    journal_append(JOURNAL_EDGE, (uint8_t)level, (uint16_t)pin);
+#endif
+    TRACE_INSTANT(TRACE_ID_BUTTON, pin, level);
+    RUNTIME_STATS_INC(input_events);
+
+    bottom_half_post(button_edge_accept, edge_us, level);
+
+    PROFILE_END(button_debounced_handler);
+}
+
+#else
+
+static debounce_t button_debounce;
+static tickless_timer_t button_settle_timer;
+
+// Time of the edge being handled
+static uint32_t button_edge_us(nrfx_gpiote_pin_t pin)
+{
+#if EDGE_CAPTURE_ENABLED
+    return edge_capture_get_us(pin);
+#else
+    return systime_us();
+#endif
+}
+
+// Now, on the clock edges are stamped with
+static uint32_t button_now_us(void)
+{
+#if EDGE_CAPTURE_ENABLED
+    return edge_capture_now_us();
+#else
+    return systime_us();
+#endif
+}
+
+static uint32_t button_level_read(uint32_t index)
+{
+    return nrf_gpio_pin_read(BUTTON);
+}
+
+static void button_settled(uint32_t index, uint32_t edge_us, uint32_t level)
+{
+    button_edge_accept(edge_us, level);
+}
+
+// Bottom half: catches an edge that was hidden in the lockout
+static void button_settle(uint32_t arg0, uint32_t arg1)
+{
+    uint32_t left_us = debounce_settle(&button_debounce, 1, button_now_us(),
+                                       button_level_read, button_settled);
+
+    if (left_us != DEBOUNCE_SETTLED)
+        tickless_timer_start(&button_settle_timer, (left_us + 999) / 1000, TICKLESS_CONFIG_SLACK_MS);
+}
+
+// Tickless timers run in thread mode, the debouncer in the bottom half
+static void button_settle_timer_handler(void *p_context)
+{
+    bottom_half_post(button_settle, 0, 0);
+}
+
+// Bottom half: adaptive software lockout after each accepted edge
+static void button_edge_process(uint32_t edge_us, uint32_t level)
+{
+    if (!debounce_edge(&button_debounce, edge_us, level))
+    {
+        RUNTIME_STATS_INC(debounce_rejections);
+        return;
+    }
+
+    button_edge_accept(edge_us, level);
+    button_settle(0, 0);
+}
+
+// Top half: capture edge time and pin level, defer everything else
+void button_handler(nrfx_gpiote_pin_t pin, nrf_gpiote_polarity_t action)
+{
+    PROFILE_BEGIN(button_handler);
+    TOP_HALF_BEGIN();
+    uint32_t edge_us = button_edge_us(pin);
+    uint32_t level = nrf_gpio_pin_read(pin);
+#if JOURNAL_CONFIG_EDGES_ENABLED
+    // raw, bounces included
+    journal_append(JOURNAL_EDGE, (uint8_t)level, (uint16_t)pin);
+#endif
+
+#if EDGE_CAPTURE_ENABLED
+    bottom_half_input_latency_record(edge_capture_now_us() - edge_us);
+#endif
+    TRACE_INSTANT(TRACE_ID_BUTTON, pin, level);
+    RUNTIME_STATS_INC(input_events);
+    bottom_half_post(button_edge_process, edge_us, level);
+
+    TOP_HALF_END();
+    PROFILE_END(button_handler);
+}
+
+#endif // BUTTON_HW_DEBOUNCE_ENABLED
+
 void gpiote_init()
 {
-    nrfx_gpiote_init();
+    if (!nrfx_gpiote_is_init())
+        nrfx_gpiote_init();
 
-    nrfx_gpiote_in_config_t config = NRFX_GPIOTE_CONFIG_IN_SENSE_TOGGLE(true);
+    // Low-power mode uses the shared PORT event; the driver flips the pin's
+    // SENSE polarity after every edge to catch both directions
+    nrfx_gpiote_in_config_t config = NRFX_GPIOTE_CONFIG_IN_SENSE_TOGGLE(!BUTTON_LOW_POWER_SENSE_ENABLED);
     config.pull = NRF_GPIO_PIN_PULLUP;
 
+#if BUTTON_HW_DEBOUNCE_ENABLED
+    nrfx_gpiote_in_init(BUTTON, &config, NULL);
+#else
     nrfx_gpiote_in_init(BUTTON, &config, button_handler);
+#endif
+#if EDGE_CAPTURE_ENABLED
+    edge_capture_attach(BUTTON);
+#endif
+#if BUTTON_HW_DEBOUNCE_ENABLED
+    hw_debounce_init(BUTTON, BUTTON_HW_DEBOUNCE_QUIET_US, button_debounced_handler);
+#else
+    // pull-up is on now
+    debounce_init(&button_debounce, nrf_gpio_pin_read(BUTTON));
+    tickless_timer_init(&button_settle_timer, button_settle_timer_handler, NULL);
     nrfx_gpiote_in_event_enable(BUTTON, true);
+#endif
 }
 
 static void startup_blink(uint32_t pin)
@@ -141,48 +631,174 @@ static void startup_blink(uint32_t pin)
     }
 }
 
-int main(void)
-{
-    nrfx_systick_init();
-    gpiote_init();
+// 20 ms frames, counted in PWM periods
+#define FRAME_PERIODS 20
+#define DUTY_MAX 1000
 
-    startup_blink(LED_1);
+// Frame clock users, FRAME_CLOCK_RENDERER is the fade
+#define FRAME_USER_RAMP 0x02
 
-    pwm_init(led_seq[0]);
+static coro_t fade_coro;
+static uint16_t fade_duty = 0;
 
-    uint16_t duty = 0;
-    int direction = 1;
+// Holds the frame clock while blinking, releases it while paused
+static bool fade_running(void)
+{
+    frame_clock_request(FRAME_CLOCK_RENDERER, blinking);
+    return blinking;
+}
+
+// Work done once per frame
+static void fade_frame_update(uint16_t duty)
+{
+    PROFILE_BEGIN(frame_update);
+    RUNTIME_STATS_INC(frames_rendered);
+    pwm_set_duty(duty);
+    PROFILE_END(frame_update);
+}
+
+// Fades the current LED up and down, then moves to the next one in led_seq.
+// Pauses at the current duty while blinking is off.
+static coro_status_t fade_thread(coro_t *c)
+{
+    CORO_BEGIN(c);
 
     while (1)
     {
-        if (blinking)
+        for (fade_duty = 0; fade_duty < DUTY_MAX; fade_duty += fade_step)
         {
-            pwm_set_duty(duty);
-            duty += direction * 10;
+            CORO_WAIT_UNTIL(c, fade_running());
+            fade_frame_update(fade_duty);
+            CORO_WAIT_EVENT(c, frame_clock_event());
+        }
 
-            if (duty >= 1000)
-            {
-                duty = 1000;
-                direction = -1;
-            }
+        // the step can change mid-fade, do not wrap below zero
+        for (fade_duty = DUTY_MAX; fade_duty > 0;
+             fade_duty = (fade_duty > fade_step) ? fade_duty - fade_step : 0)
+        {
+            CORO_WAIT_UNTIL(c, fade_running());
+            fade_frame_update(fade_duty);
+            CORO_WAIT_EVENT(c, frame_clock_event());
+        }
 
-            if (duty == 0)
-            {
-                direction = 1;
+        // switch off, no frames are wanted until the next LED starts
+        pwm_set_duty(0);
+        frame_clock_request(FRAME_CLOCK_RENDERER, false);
+        CORO_WAIT_MS(c, 5);
 
-                // switch off
-                pwm_set_duty(0);
-                nrf_delay_ms(5);
+        led_index = (led_index + 1) % SEQ_LENGTH;
+        pwm_switch_led(led_seq[led_index]);
+    }
 
-                led_index = (led_index + 1) % SEQ_LENGTH;
-                pwm_switch_led(led_seq[led_index]);
-            }
+    CORO_END(c);
+}
 
-            nrf_delay_ms(20);
-        }
-        else
-        {
-            nrf_delay_ms(20);
-        }
+static coro_t ramp_coro;
+static uint32_t ramp_frame;
+
+// Holds the frame clock while a hold is ramping
+static bool ramp_running(void)
+{
+    bool ramping = brightness_ramping();
+
+    frame_clock_request(FRAME_USER_RAMP, ramping);
+    return ramping;
+}
+
+// Steps the brightness once per PWM frame while a hold is ramping it
+static coro_status_t ramp_thread(coro_t *c)
+{
+    CORO_BEGIN(c);
+
+    while (1)
+    {
+        CORO_WAIT_UNTIL(c, ramp_running());
+
+        ramp_frame = frame_clock_count();
+        CORO_WAIT_UNTIL(c, frame_clock_count() != ramp_frame);
+
+        brightness_ramp_step();
+    }
+
+    CORO_END(c);
+}
+
+int main(void)
+{
+    // before anything can take an interrupt
+    ram_usage_init();
+    crash_init();
+    systime_init();
+#if NRF_LOG_ENABLED
+    APP_ERROR_CHECK(NRF_LOG_INIT(log_timestamp));
+    NRF_LOG_DEFAULT_BACKENDS_INIT();
+#endif
+    crash_print();
+    journal_init();
+    // what happened before this reset
+    journal_dump(journal_print);
+    bottom_half_init();
+#if INPUT_BENCH_ENABLED
+    // before anything that keeps HFCLK running
+    input_bench_run();
+    input_bench_print();
+#endif
+#if ENERGY_ENABLED
+    // after the benchmark, its sleeps and stimulus are not normal running
+    energy_init();
+#endif
+    gesture_init(gesture_handler);
+#if EDGE_CAPTURE_ENABLED
+    edge_capture_init();
+#endif
+    // after the clock it stamps events with
+    trace_init();
+    gpiote_init();
+#if ENCODER_ENABLED
+    encoder_init(ENCODER_A, ENCODER_B, encoder_handler);
+#endif
+#if INPUT_BANK_ENABLED
+    input_bank_init(bank_pins, BANK_PIN_COUNT, bank_handler);
+#endif
+#if AMBIENT_ENABLED
+    // takes RTC1 over from the input benchmark
+    ambient_init();
+#endif
+#if THERMAL_ENABLED
+    thermal_init();
+#endif
+
+    startup_blink(LED_1);
+
+    pwm_init(led_seq[0]);
+    frame_clock_init(nrfx_pwm_event_address_get(&pwm0, NRF_PWM_EVENT_PWMPERIODEND), FRAME_PERIODS);
+#if LATENCY_ENABLED
+    latency_init(nrfx_pwm_event_address_get(&pwm0, NRF_PWM_EVENT_PWMPERIODEND));
+#endif
+
+    CORO_INIT(&fade_coro);
+    CORO_INIT(&ramp_coro);
+    runtime_stats_init();
+#if WATCHDOG_ENABLED
+    // last, so a slow startup does not count against the deadlines
+    watchdog_init();
+#endif
+
+    while (1)
+    {
+        fade_thread(&fade_coro);
+        ramp_thread(&ramp_coro);
+        pwm_refresh();
+#if WATCHDOG_ENABLED
+        watchdog_checkin(WATCHDOG_TASK_RENDER);
+#endif
+#if LATENCY_ENABLED
+        latency_collect();
+#endif
+        // deferred logs are only written out here, one per pass, so
+        // interrupts never wait for RTT
+        if (NRF_LOG_PROCESS())
+            tickless_notify();
+        tickless_idle();
     }
 }
@@ -0,0 +1,38 @@
+#include <nrfx.h>
+#include "profile.h"
+
+#if PROFILE_ENABLED
+
+static profile_site_t *p_sites = NULL;
+
+static uint32_t log2_bin(uint32_t cycles)
+{
+    return cycles ? 31 - __CLZ(cycles) : 0;
+}
+
+void profile_record(profile_site_t *p_site, uint32_t cycles)
+{
+    if (!p_site->registered)
+    {
+        NRFX_CRITICAL_SECTION_ENTER();
+        p_site->p_next = p_sites;
+        p_sites = p_site;
+        p_site->registered = true;
+        NRFX_CRITICAL_SECTION_EXIT();
+    }
+
+    p_site->count++;
+    p_site->total_cycles += cycles;
+    if (cycles < p_site->min_cycles)
+        p_site->min_cycles = cycles;
+    if (cycles > p_site->max_cycles)
+        p_site->max_cycles = cycles;
+    p_site->histogram[log2_bin(cycles)]++;
+}
+
+profile_site_t const *profile_sites(void)
+{
+    return p_sites;
+}
+
+#endif // PROFILE_ENABLED
@@ -0,0 +1,67 @@
+#ifndef PROFILE_H__
+#define PROFILE_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <sdk_config.h>
+#include "cycles.h"
+
+// Cycle-count profiling of named code regions.
+//
+//     PROFILE_BEGIN(site);
+//     ...
+//     PROFILE_END(site);
+//
+// Each site keeps count, min, max, total and a log2 histogram of its
+// DWT cycle counts, in RAM. A site registers itself on its first run, so
+// there is no central list to maintain. Record a site from one context
+// only. With PROFILE_ENABLED set to 0 the macros compile to nothing.
+// Cycles stop while the CPU sleeps; do not profile across a wait.
+
+#define PROFILE_HIST_BINS 32
+
+typedef struct profile_site_s
+{
+    const char *name;
+    struct profile_site_s *p_next;
+    bool registered;
+    uint32_t count;
+    uint32_t min_cycles;
+    uint32_t max_cycles;
+    uint64_t total_cycles;
+    uint32_t histogram[PROFILE_HIST_BINS]; // bin n: 2^n to 2^(n+1)-1 cycles
+} profile_site_t;
+
+#if PROFILE_ENABLED
+
+#define PROFILE_BEGIN(site)                                                                 \
+    static profile_site_t profile_site_##site = {.name = #site, .min_cycles = UINT32_MAX}; \
+    uint32_t profile_start_##site = cycles_now()
+
+#define PROFILE_END(site) profile_record(&profile_site_##site, cycles_now() - profile_start_##site)
+
+#else
+
+#define PROFILE_BEGIN(site) \
+    do                      \
+    {                       \
+    } while (0)
+
+#define PROFILE_END(site) \
+    do                    \
+    {                     \
+    } while (0)
+
+#endif // PROFILE_ENABLED
+
+void profile_record(profile_site_t *p_site, uint32_t cycles);
+
+// Sites seen so far, most recently registered first
+profile_site_t const *profile_sites(void);
+
+static inline uint32_t profile_mean_cycles(profile_site_t const *p_site)
+{
+    return p_site->count ? (uint32_t)(p_site->total_cycles / p_site->count) : 0;
+}
+
+#endif // PROFILE_H__
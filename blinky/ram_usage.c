@@ -0,0 +1,67 @@
+#include <nrfx.h>
+#include "ram_usage.h"
+
+#define PAINT 0xA5A5A5A5UL
+
+// From nrf_common.ld
+extern uint32_t __StackTop;
+extern uint32_t __StackLimit;
+extern uint32_t __HeapBase;
+extern uint32_t __HeapLimit;
+
+static uint32_t thread_sp;
+static volatile uint32_t isr_sp_min = UINT32_MAX;
+
+// noinline, so the region ends below this frame and not below main()'s
+static __attribute__((noinline)) void stack_paint(void)
+{
+    uint32_t *p_word = &__StackLimit;
+    uint32_t *p_sp = (uint32_t *)(uintptr_t)__get_MSP();
+
+    while (p_word < p_sp)
+        *p_word++ = PAINT;
+}
+
+void ram_usage_init(void)
+{
+    thread_sp = __get_MSP();
+    stack_paint();
+
+    for (uint32_t *p_word = &__HeapBase; p_word < &__HeapLimit; p_word++)
+        *p_word = PAINT;
+}
+
+void ram_usage_isr_sample(void)
+{
+    uint32_t sp = __get_MSP();
+
+    if (__get_IPSR() == 0)
+        return;
+
+    NRFX_CRITICAL_SECTION_ENTER();
+    if (sp < isr_sp_min)
+        isr_sp_min = sp;
+    NRFX_CRITICAL_SECTION_EXIT();
+}
+
+void ram_usage_get(ram_usage_t *p_usage)
+{
+    uint32_t top = (uint32_t)(uintptr_t)&__StackTop;
+    uint32_t *p_word = &__StackLimit;
+    uint32_t sp_min = isr_sp_min;
+
+    // the stack grows down: the first overwritten word from the limit up
+    while (p_word < &__StackTop && *p_word == PAINT)
+        p_word++;
+    p_usage->stack_size = top - (uint32_t)(uintptr_t)&__StackLimit;
+    p_usage->stack_peak = top - (uint32_t)(uintptr_t)p_word;
+    p_usage->stack_thread = top - thread_sp;
+    p_usage->stack_isr_peak = (sp_min == UINT32_MAX) ? 0 : top - sp_min;
+
+    // the heap grows up: the first overwritten word from the limit down
+    p_word = &__HeapLimit;
+    while (p_word > &__HeapBase && p_word[-1] == PAINT)
+        p_word--;
+    p_usage->heap_size = (uint32_t)(uintptr_t)&__HeapLimit - (uint32_t)(uintptr_t)&__HeapBase;
+    p_usage->heap_peak = (uint32_t)(uintptr_t)p_word - (uint32_t)(uintptr_t)&__HeapBase;
+}
@@ -0,0 +1,38 @@
+#ifndef RAM_USAGE_H__
+#define RAM_USAGE_H__
+
+#include <stdint.h>
+
+// Stack and heap high-water marks, to size __STACK_SIZE / __HEAP_SIZE
+// (Makefile STACK_SIZE / HEAP_SIZE) from measurements.
+//
+// ram_usage_init() fills the free stack below the caller and the whole
+// heap with a pattern. A query scans for the first overwritten word, so
+// the marks are the deepest the regions have ever been used since boot.
+// Interrupts run on the same main stack (MSP) as thread mode; to tell
+// their share apart, ram_usage_isr_sample() keeps the lowest SP seen in
+// interrupt context. It is only called from bottom_half_post(), i.e. at
+// the points where interrupts hand work on, so deeper calls elsewhere
+// (a bottom half item, a preempting handler) go unseen: stack_isr_peak is
+// a lower bound. stack_peak is exact and includes them.
+
+typedef struct
+{
+    uint32_t stack_size;       // bytes reserved for the main stack
+    uint32_t stack_peak;       // deepest use, thread mode and interrupts together
+    uint32_t stack_thread;     // depth of main() when ram_usage_init() ran
+    uint32_t stack_isr_peak;   // deepest SP sampled in interrupt context, a lower bound; 0 if none
+    uint32_t heap_size;        // bytes reserved for the heap
+    uint32_t heap_peak;        // highest heap byte ever written
+} ram_usage_t;
+
+// Call first thing in main(), before any interrupt is enabled
+void ram_usage_init(void);
+
+// Records the current SP if it is the deepest seen in an interrupt
+void ram_usage_isr_sample(void);
+
+// Scans the painted regions, O(size of the untouched part)
+void ram_usage_get(ram_usage_t *p_usage);
+
+#endif // RAM_USAGE_H__
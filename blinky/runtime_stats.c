@@ -0,0 +1,63 @@
+#include <nrfx.h>
+#include "runtime_stats.h"
+#include "systime.h"
+#include "tickless.h"
+#include "frame_clock.h"
+#include "bottom_half.h"
+#include "cpu_load.h"
+
+// not static, so a debugger can find them by name
+runtime_stats_counters_t runtime_stats_counters;
+runtime_stats_t runtime_stats_latest;
+
+#if RUNTIME_STATS_CONFIG_REFRESH_MS
+static tickless_timer_t timer;
+
+// Thread mode, from tickless_idle(); the slack lets it ride on other wakeups
+static void timer_handler(void *p_context)
+{
+    runtime_stats_snapshot(&runtime_stats_latest);
+    tickless_timer_start(&timer, RUNTIME_STATS_CONFIG_REFRESH_MS, RUNTIME_STATS_CONFIG_REFRESH_MS / 4);
+}
+#endif
+
+void runtime_stats_init(void)
+{
+#if RUNTIME_STATS_CONFIG_REFRESH_MS
+    tickless_timer_init(&timer, timer_handler, NULL);
+    timer_handler(NULL);
+#endif
+}
+
+void runtime_stats_snapshot(runtime_stats_t *p_stats)
+{
+    frame_clock_stats_t frame_clock;
+    bottom_half_stats_t bottom_half;
+    tickless_stats_t tickless;
+    cpu_load_t load;
+
+    frame_clock_stats_get(&frame_clock);
+    bottom_half_stats_get(&bottom_half);
+    tickless_stats_get(&tickless);
+    cpu_load_get(&load);
+
+    p_stats->version = RUNTIME_STATS_VERSION;
+    p_stats->size = sizeof(runtime_stats_t);
+    p_stats->uptime_ms = systime_ms();
+    p_stats->frames = frame_clock.frames;
+    p_stats->frames_rendered = runtime_stats_counters.frames_rendered;
+    p_stats->frames_dropped = frame_clock.missed;
+    p_stats->pwm_restarts = runtime_stats_counters.pwm_restarts;
+    p_stats->input_events = runtime_stats_counters.input_events;
+    p_stats->debounce_rejections = runtime_stats_counters.debounce_rejections;
+    p_stats->gestures = runtime_stats_counters.gestures;
+    p_stats->bottom_half_posted = bottom_half.posted;
+    p_stats->bottom_half_dropped = bottom_half.dropped;
+    p_stats->sleeps = tickless.sleeps;
+    p_stats->rtc_wakeups = tickless.rtc_wakeups;
+    p_stats->cpu_load_permille = load.last_permille;
+    p_stats->cpu_load_peak_permille = load.peak_permille;
+    p_stats->top_half_max_cycles = bottom_half.top_half_max_cycles;
+    p_stats->bottom_half_max_cycles = bottom_half.work_max_cycles;
+    p_stats->input_max_us = bottom_half.input_max_us;
+}
@@ -0,0 +1,65 @@
+#ifndef RUNTIME_STATS_H__
+#define RUNTIME_STATS_H__
+
+#include <stdint.h>
+#include <nrf.h>
+#include <nrf_atomic.h>
+#include <sdk_config.h>
+
+// Whole-system counters in one packed struct.
+//
+// Counters that no module kept before live in runtime_stats_counters and
+// are bumped with RUNTIME_STATS_INC(), an LDREX/STREX add that is safe
+// from any priority without masking interrupts. runtime_stats_snapshot()
+// adds the module statistics (frame clock, bottom half, tickless, CPU
+// load) to them; every field is read atomically on its own, the set as a
+// whole is not frozen. A tickless timer also refreshes
+// runtime_stats_latest every RUNTIME_STATS_CONFIG_REFRESH_MS, so a
+// debugger can read it by name while the firmware runs.
+
+// Bump when fields change; transports check it together with size
+#define RUNTIME_STATS_VERSION 1
+
+typedef struct
+{
+    nrf_atomic_u32_t frames_rendered;     // frames that updated the PWM duty
+    nrf_atomic_u32_t pwm_restarts;        // PWM re-initialized for another LED
+    nrf_atomic_u32_t input_events;        // input top halves run
+    nrf_atomic_u32_t debounce_rejections; // edges dropped as bounce
+    nrf_atomic_u32_t gestures;
+} runtime_stats_counters_t;
+
+typedef __PACKED_STRUCT
+{
+    uint16_t version; // RUNTIME_STATS_VERSION
+    uint16_t size;    // sizeof(runtime_stats_t)
+    uint32_t uptime_ms;
+    uint32_t frames;              // frame clock events
+    uint32_t frames_rendered;
+    uint32_t frames_dropped;      // frame events not taken in time
+    uint32_t pwm_restarts;
+    uint32_t input_events;
+    uint32_t debounce_rejections;
+    uint32_t gestures;
+    uint32_t bottom_half_posted;
+    uint32_t bottom_half_dropped;
+    uint32_t sleeps;
+    uint32_t rtc_wakeups;
+    uint16_t cpu_load_permille;   // last complete window
+    uint16_t cpu_load_peak_permille;
+    uint32_t top_half_max_cycles;
+    uint32_t bottom_half_max_cycles;
+    uint32_t input_max_us;        // hardware edge to top half
+} runtime_stats_t;
+
+extern runtime_stats_counters_t runtime_stats_counters;
+
+#define RUNTIME_STATS_INC(counter) ((void)nrf_atomic_u32_add(&runtime_stats_counters.counter, 1))
+
+// Starts the refresh of runtime_stats_latest, if configured
+void runtime_stats_init(void);
+
+// Safe from thread mode and the bottom half
+void runtime_stats_snapshot(runtime_stats_t *p_stats);
+
+#endif // RUNTIME_STATS_H__
@@ -0,0 +1,115 @@
+#include <nrfx.h>
+#include <nrf_rtc.h>
+#include <nrf_clock.h>
+#include "systime.h"
+#include "irq_priority.h"
+#include "bottom_half.h"
+
+#define SYSTIME_RTC NRF_RTC2
+#define RTC_COUNTER_MASK 0x00FFFFFFUL
+
+static volatile uint32_t overflows = 0;
+static volatile bool alarm_fired = false;
+
+static void lfclk_start(void)
+{
+    if (nrf_clock_lf_is_running())
+        return;
+
+    nrf_clock_lf_src_set((nrf_clock_lfclk_t)SYSTIME_CONFIG_LFCLK_SRC);
+    nrf_clock_event_clear(NRF_CLOCK_EVENT_LFCLKSTARTED);
+    nrf_clock_task_trigger(NRF_CLOCK_TASK_LFCLKSTART);
+    while (!nrf_clock_event_check(NRF_CLOCK_EVENT_LFCLKSTARTED))
+    {
+    }
+}
+
+void systime_init(void)
+{
+    lfclk_start();
+
+    nrf_rtc_prescaler_set(SYSTIME_RTC, 0);
+    nrf_rtc_event_clear(SYSTIME_RTC, NRF_RTC_EVENT_OVERFLOW);
+    nrf_rtc_int_enable(SYSTIME_RTC, NRF_RTC_INT_OVERFLOW_MASK);
+
+    NRFX_IRQ_PRIORITY_SET(RTC2_IRQn, IRQ_PRIORITY_TIMEBASE);
+    NRFX_IRQ_ENABLE(RTC2_IRQn);
+
+    nrf_rtc_task_trigger(SYSTIME_RTC, NRF_RTC_TASK_START);
+}
+
+uint64_t systime_ticks(void)
+{
+    uint32_t snapshot;
+    uint32_t ovf;
+    uint32_t counter;
+
+    do
+    {
+        snapshot = overflows;
+        ovf = snapshot;
+        counter = nrf_rtc_counter_get(SYSTIME_RTC);
+
+        // Overflow not yet accounted by the interrupt (caller may outrank it)
+        if (nrf_rtc_event_pending(SYSTIME_RTC, NRF_RTC_EVENT_OVERFLOW))
+        {
+            counter = nrf_rtc_counter_get(SYSTIME_RTC);
+            ovf++;
+        }
+    } while (snapshot != overflows);
+
+    return ((uint64_t)ovf << 24) | counter;
+}
+
+uint32_t systime_ms(void)
+{
+    return SYSTIME_TICKS_TO_MS(systime_ticks());
+}
+
+uint32_t systime_us(void)
+{
+    return (uint32_t)((systime_ticks() * 1000000ULL) / SYSTIME_TICK_HZ);
+}
+
+void systime_alarm_set(uint64_t ticks)
+{
+    nrf_rtc_int_disable(SYSTIME_RTC, NRF_RTC_INT_COMPARE0_MASK);
+    alarm_fired = false;
+    nrf_rtc_event_clear(SYSTIME_RTC, NRF_RTC_EVENT_COMPARE_0);
+    nrf_rtc_cc_set(SYSTIME_RTC, 0, (uint32_t)ticks & RTC_COUNTER_MASK);
+    nrf_rtc_int_enable(SYSTIME_RTC, NRF_RTC_INT_COMPARE0_MASK);
+}
+
+void systime_alarm_cancel(void)
+{
+    nrf_rtc_int_disable(SYSTIME_RTC, NRF_RTC_INT_COMPARE0_MASK);
+    nrf_rtc_event_clear(SYSTIME_RTC, NRF_RTC_EVENT_COMPARE_0);
+}
+
+bool systime_alarm_take(void)
+{
+    if (!alarm_fired)
+        return false;
+    alarm_fired = false;
+    return true;
+}
+
+void RTC2_IRQHandler(void)
+{
+    TOP_HALF_BEGIN();
+
+    if (nrf_rtc_event_pending(SYSTIME_RTC, NRF_RTC_EVENT_COMPARE_0))
+    {
+        nrf_rtc_event_clear(SYSTIME_RTC, NRF_RTC_EVENT_COMPARE_0);
+        nrf_rtc_int_disable(SYSTIME_RTC, NRF_RTC_INT_COMPARE0_MASK);
+        alarm_fired = true;
+    }
+
+    if (nrf_rtc_event_pending(SYSTIME_RTC, NRF_RTC_EVENT_OVERFLOW))
+    {
+        nrf_rtc_event_clear(SYSTIME_RTC, NRF_RTC_EVENT_OVERFLOW);
+        overflows++;
+    }
+
+    TOP_HALF_END();
+}
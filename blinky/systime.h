@@ -0,0 +1,39 @@
+#ifndef SYSTIME_H__
+#define SYSTIME_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Free-running system time kept by RTC2 on the 32.768 kHz LFCLK.
+// The 24-bit counter is extended to 64 bits with the overflow interrupt.
+
+#define SYSTIME_TICK_HZ 32768UL
+
+#define SYSTIME_MS_TO_TICKS(ms) ((((uint64_t)(ms)) * SYSTIME_TICK_HZ + 999) / 1000)
+#define SYSTIME_TICKS_TO_MS(ticks) ((uint32_t)((((uint64_t)(ticks)) * 1000) / SYSTIME_TICK_HZ))
+
+void systime_init(void);
+
+uint64_t systime_ticks(void);
+
+uint32_t systime_ms(void);
+
+// Microseconds at RTC resolution (~30.5 us), wraps every ~71 minutes
+uint32_t systime_us(void);
+
+// One-shot RTC compare used to wake the CPU at an absolute tick count.
+// The alarm must be at least two ticks in the future.
+void systime_alarm_set(uint64_t ticks);
+
+void systime_alarm_cancel(void);
+
+// Returns true once after the alarm has fired
+bool systime_alarm_take(void);
+
+// True once deadline_ms has passed, safe across the 32-bit wrap
+static inline bool systime_reached(uint32_t deadline_ms)
+{
+    return (int32_t)(systime_ms() - deadline_ms) >= 0;
+}
+
+#endif // SYSTIME_H__
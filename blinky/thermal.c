@@ -0,0 +1,89 @@
+#include <nrfx_temp.h>
+#include <app_error.h>
+#include "thermal.h"
+#include "irq_priority.h"
+#include "tickless.h"
+#include "bottom_half.h"
+
+#if THERMAL_ENABLED
+
+#define NRF_LOG_MODULE_NAME thermal
+#define NRF_LOG_LEVEL THERMAL_CONFIG_LOG_LEVEL
+#include <nrf_log.h>
+NRF_LOG_MODULE_REGISTER();
+
+#define FULL_DUTY 1000
+#define START_MC (THERMAL_CONFIG_DERATE_START_C * 1000L)
+#define END_MC (THERMAL_CONFIG_DERATE_END_C * 1000L)
+
+STATIC_ASSERT(THERMAL_CONFIG_DERATE_END_C > THERMAL_CONFIG_DERATE_START_C);
+
+static tickless_timer_t timer;
+static volatile uint16_t max_duty = FULL_DUTY;
+static thermal_stats_t stats = {.temp_max_mc = INT32_MIN, .max_duty = FULL_DUTY};
+
+static uint16_t derate(int32_t temp_mc)
+{
+    if (temp_mc <= START_MC)
+        return FULL_DUTY;
+    if (temp_mc >= END_MC)
+        return THERMAL_CONFIG_MIN_PERMILLE;
+
+    return FULL_DUTY - (uint16_t)(((int64_t)(FULL_DUTY - THERMAL_CONFIG_MIN_PERMILLE) * (temp_mc - START_MC)) /
+                                  (END_MC - START_MC));
+}
+
+// TEMP interrupt
+static void temp_handler(int32_t raw_temperature)
+{
+    TOP_HALF_BEGIN();
+    // nrfx_temp_calculate() gives 0.01 degree steps
+    int32_t temp_mc = nrfx_temp_calculate(raw_temperature) * 10;
+    uint16_t duty = derate(temp_mc);
+
+    if ((duty < FULL_DUTY) != (max_duty < FULL_DUTY))
+        NRF_LOG_WARNING("%s at %d mC", (duty < FULL_DUTY) ? "derating" : "full duty", temp_mc);
+    NRF_LOG_DEBUG("%d mC, duty limit %u", temp_mc, duty);
+    max_duty = duty;
+
+    stats.measurements++;
+    stats.temp_mc = temp_mc;
+    if (temp_mc > stats.temp_max_mc)
+        stats.temp_max_mc = temp_mc;
+    stats.max_duty = max_duty;
+
+    // let the main loop re-apply the duty
+    tickless_notify();
+
+    TOP_HALF_END();
+}
+
+// Thread mode, from tickless_idle()
+static void timer_handler(void *p_context)
+{
+    APP_ERROR_CHECK(nrfx_temp_measure());
+    tickless_timer_start(&timer, THERMAL_CONFIG_PERIOD_MS, THERMAL_CONFIG_PERIOD_MS / 4);
+}
+
+void thermal_init(void)
+{
+    nrfx_temp_config_t config = {
+        .interrupt_priority = IRQ_PRIORITY_LOW};
+
+    APP_ERROR_CHECK(nrfx_temp_init(&config, temp_handler));
+
+    tickless_timer_init(&timer, timer_handler, NULL);
+    timer_handler(NULL);
+}
+
+uint16_t thermal_max_duty(void)
+{
+    return max_duty;
+}
+
+void thermal_stats_get(thermal_stats_t *p_stats)
+{
+    *p_stats = stats;
+}
+
+#endif // THERMAL_ENABLED
@@ -0,0 +1,29 @@
+#ifndef THERMAL_H__
+#define THERMAL_H__
+
+#include <stdint.h>
+
+// Thermal derating from the on-chip TEMP sensor.
+//
+// A tickless timer starts a measurement every THERMAL_CONFIG_PERIOD_MS
+// with generous slack, so it rides along with other wakeups. The TEMP
+// interrupt converts the result and updates the duty limit: full duty up
+// to THERMAL_CONFIG_DERATE_START_C, falling linearly to
+// THERMAL_CONFIG_MIN_PERMILLE at THERMAL_CONFIG_DERATE_END_C and above.
+
+typedef struct
+{
+    uint32_t measurements;
+    int32_t temp_mc;     // last reading, millidegrees Celsius
+    int32_t temp_max_mc; // hottest reading
+    uint16_t max_duty;   // current limit, permille
+} thermal_stats_t;
+
+void thermal_init(void);
+
+// Highest duty allowed right now, permille
+uint16_t thermal_max_duty(void);
+
+void thermal_stats_get(thermal_stats_t *p_stats);
+
+#endif // THERMAL_H__
@@ -0,0 +1,253 @@
+#include <nrfx.h>
+#include "tickless.h"
+#include "systime.h"
+#include "trace.h"
+#include "cpu_load.h"
+#include "energy.h"
+
+// RTC compare needs the CC at least two ticks ahead of the counter
+#define MIN_SLEEP_TICKS 3
+// Longest single sleep, well inside the 24-bit compare range
+#define MAX_SLEEP_TICKS (1ULL << 23)
+
+#define NO_WAKEUP UINT64_MAX
+
+typedef struct
+{
+    uint64_t deadline;
+    uint64_t latest;
+} window_t;
+
+static tickless_timer_t *p_timers = NULL;
+static volatile bool notified = false;
+
+static window_t windows[TICKLESS_CONFIG_MAX_WINDOWS];
+static uint32_t window_count = 0;
+
+static tickless_stats_t stats;
+
+static void window_add(uint64_t deadline, uint64_t slack)
+{
+    if (window_count < TICKLESS_CONFIG_MAX_WINDOWS)
+    {
+        windows[window_count].deadline = deadline;
+        windows[window_count].latest = deadline + slack;
+        window_count++;
+        if (window_count > stats.windows_peak)
+            stats.windows_peak = window_count;
+    }
+    else
+    {
+        // out of slots, fold into the last one without loosening either bound
+        window_t *p_last = &windows[TICKLESS_CONFIG_MAX_WINDOWS - 1];
+
+        if (deadline < p_last->deadline)
+            p_last->deadline = deadline;
+        if (deadline + slack < p_last->latest)
+            p_last->latest = deadline + slack;
+    }
+}
+
+void tickless_timer_init(tickless_timer_t *p_timer, tickless_handler_t handler, void *p_context)
+{
+    p_timer->handler = handler;
+    p_timer->p_context = p_context;
+    p_timer->active = false;
+
+    NRFX_CRITICAL_SECTION_ENTER();
+    p_timer->p_next = p_timers;
+    p_timers = p_timer;
+    NRFX_CRITICAL_SECTION_EXIT();
+}
+
+void tickless_timer_start(tickless_timer_t *p_timer, uint32_t timeout_ms, uint32_t slack_ms)
+{
+    uint64_t deadline = systime_ticks() + SYSTIME_MS_TO_TICKS(timeout_ms);
+
+    NRFX_CRITICAL_SECTION_ENTER();
+    p_timer->deadline = deadline;
+    p_timer->slack = (uint32_t)SYSTIME_MS_TO_TICKS(slack_ms);
+    p_timer->active = true;
+    NRFX_CRITICAL_SECTION_EXIT();
+
+    // re-plan the sleep if this raced with tickless_idle()
+    notified = true;
+}
+
+void tickless_timer_stop(tickless_timer_t *p_timer)
+{
+    p_timer->active = false;
+}
+
+void tickless_hint(uint32_t deadline_ms, uint32_t slack_ms)
+{
+    uint64_t now = systime_ticks();
+    int32_t remaining = (int32_t)(deadline_ms - SYSTIME_TICKS_TO_MS(now));
+
+    if (remaining < 0)
+        remaining = 0;
+
+    window_add(now + SYSTIME_MS_TO_TICKS(remaining), SYSTIME_MS_TO_TICKS(slack_ms));
+}
+
+void tickless_notify(void)
+{
+    notified = true;
+}
+
+static void timers_run(uint64_t now)
+{
+    for (tickless_timer_t *p_timer = p_timers; p_timer != NULL; p_timer = p_timer->p_next)
+    {
+        bool expired = false;
+
+        NRFX_CRITICAL_SECTION_ENTER();
+        if (p_timer->active && p_timer->deadline <= now)
+        {
+            p_timer->active = false;
+            expired = true;
+        }
+        NRFX_CRITICAL_SECTION_EXIT();
+
+        if (expired)
+        {
+            p_timer->handler(p_timer->p_context);
+            // the handler may have unblocked a coroutine
+            notified = true;
+        }
+    }
+}
+
+static void timers_collect(void)
+{
+    for (tickless_timer_t *p_timer = p_timers; p_timer != NULL; p_timer = p_timer->p_next)
+    {
+        NRFX_CRITICAL_SECTION_ENTER();
+        if (p_timer->active)
+            window_add(p_timer->deadline, p_timer->slack);
+        NRFX_CRITICAL_SECTION_EXIT();
+    }
+}
+
+// Latest wakeup that honours every window. Also counts how many distinct
+// deadlines beyond the first fall due by then, i.e. wakeups merged away.
+static uint64_t wakeup_plan(uint32_t *p_merged)
+{
+    uint64_t wake = NO_WAKEUP;
+    uint32_t distinct = 0;
+
+    for (uint32_t i = 0; i < window_count; i++)
+    {
+        if (windows[i].latest < wake)
+            wake = windows[i].latest;
+    }
+
+    for (uint32_t i = 0; i < window_count; i++)
+    {
+        if (windows[i].deadline > wake)
+            continue;
+
+        bool seen = false;
+        for (uint32_t j = 0; j < i; j++)
+        {
+            if (windows[j].deadline == windows[i].deadline)
+            {
+                seen = true;
+                break;
+            }
+        }
+        if (!seen)
+            distinct++;
+    }
+
+    *p_merged = (distinct > 1) ? distinct - 1 : 0;
+    return wake;
+}
+
+static void cpu_sleep(void)
+{
+#if (__FPU_USED == 1)
+    // A pending FPU exception would keep the CPU from sleeping
+    __set_FPSCR(__get_FPSCR() & ~(0x0000009F));
+    (void)__get_FPSCR();
+    NVIC_ClearPendingIRQ(FPU_IRQn);
+#endif
+
+    // With PRIMASK set, WFI still wakes on a pending interrupt; it is taken
+    // once interrupts are enabled again
+    __WFI();
+}
+
+void tickless_idle(void)
+{
+    uint32_t merged = 0;
+    uint64_t wake;
+    uint64_t now;
+
+    timers_run(systime_ticks());
+
+    // hints from this main loop pass are already in windows[]
+    timers_collect();
+    wake = wakeup_plan(&merged);
+    window_count = 0;
+
+    cpu_load_update(systime_ticks());
+
+    // Armed with interrupts masked, so nothing can run between reading the
+    // counter and deciding to sleep
+    __disable_irq();
+    now = systime_ticks();
+    if (wake == NO_WAKEUP)
+    {
+        systime_alarm_cancel();
+    }
+    else if (wake < now + MIN_SLEEP_TICKS)
+    {
+        // something is due right away, keep running
+        __enable_irq();
+        return;
+    }
+    else
+    {
+        if (wake - now > MAX_SLEEP_TICKS)
+        {
+            wake = now + MAX_SLEEP_TICKS;
+            merged = 0;
+        }
+        systime_alarm_set(wake);
+
+        // the compare is missed if the counter got within two ticks of it
+        // while it was being written; treat that as due
+        if (wake < systime_ticks() + MIN_SLEEP_TICKS)
+            notified = true;
+    }
+
+    if (!notified)
+    {
+        uint64_t sleep_start = systime_ticks();
+
+        stats.sleeps++;
+        TRACE_BEGIN(TRACE_ID_IDLE, (uint32_t)wake, 0);
+        cpu_sleep();
+        TRACE_END(TRACE_ID_IDLE);
+        // still masked, so the waking interrupt is pending in the NVIC
+        uint64_t sleep_end = systime_ticks();
+        cpu_load_sleep_record(sleep_start, sleep_end);
+#if ENERGY_ENABLED
+        energy_sleep_record(sleep_start, sleep_end);
+#endif
+    }
+    notified = false;
+    __enable_irq();
+
+    if (systime_alarm_take())
+    {
+        stats.rtc_wakeups++;
+        stats.wakeups_saved += merged;
+    }
+}
+
+void tickless_stats_get(tickless_stats_t *p_stats)
+{
+    *p_stats = stats;
+}
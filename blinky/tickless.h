@@ -0,0 +1,56 @@
+#ifndef TICKLESS_H__
+#define TICKLESS_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Tickless idle with timeout coalescing.
+//
+// Every pending timeout is a window [deadline, deadline + slack]. Before
+// sleeping, the idle loop picks the latest wakeup that still honours the
+// most urgent window, so all timeouts that fall due by then are served by
+// one RTC wakeup instead of one each.
+
+typedef void (*tickless_handler_t)(void *p_context);
+
+typedef struct tickless_timer_s
+{
+    struct tickless_timer_s *p_next;
+    tickless_handler_t handler;
+    void *p_context;
+    uint64_t deadline;
+    uint32_t slack;
+    volatile bool active;
+} tickless_timer_t;
+
+typedef struct
+{
+    uint32_t sleeps;        // times the CPU went to sleep
+    uint32_t rtc_wakeups;   // sleeps ended by the RTC alarm
+    uint32_t wakeups_saved; // RTC wakeups avoided by merging timeouts
+    uint32_t windows_peak;  // most windows planned at once, of TICKLESS_CONFIG_MAX_WINDOWS
+} tickless_stats_t;
+
+// Registers a timer; handlers run from tickless_idle() in thread mode
+void tickless_timer_init(tickless_timer_t *p_timer, tickless_handler_t handler, void *p_context);
+
+// (Re)starts a one-shot timer. May be called from interrupt context.
+void tickless_timer_start(tickless_timer_t *p_timer, uint32_t timeout_ms, uint32_t slack_ms);
+
+void tickless_timer_stop(tickless_timer_t *p_timer);
+
+// Asks the next idle not to sleep past deadline_ms (+ slack_ms).
+// Only valid for the current main loop pass, so call it every time.
+void tickless_hint(uint32_t deadline_ms, uint32_t slack_ms);
+
+// Marks that an interrupt produced work for the main loop, so the next
+// idle does not go to sleep
+void tickless_notify(void);
+
+// Runs expired timers, then sleeps until the next coalesced wakeup or
+// until any interrupt
+void tickless_idle(void);
+
+void tickless_stats_get(tickless_stats_t *p_stats);
+
+#endif // TICKLESS_H__
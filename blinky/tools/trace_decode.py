@@ -0,0 +1,149 @@
+#!/usr/bin/env python3
+"""Turn a RAM dump holding trace_buffer (trace.c) into Chrome trace JSON.
+
+Dump the RAM of a running or halted target, e.g.
+
+    nrfjprog --readram ram.bin
+
+then
+
+    tools/trace_decode.py ram.bin -o trace.json [--elf _build/nrf52840_xxaa.out]
+
+and open trace.json in chrome://tracing or https://ui.perfetto.dev.
+The buffer is found by its magic word, so any dump that contains it will
+do. Event names come from the trace_id_t enum in trace.h. Each boot found
+in the ring is shown as its own process, each interrupt as a thread.
+"""
+
+import argparse
+import json
+import os
+import re
+import struct
+import subprocess
+import sys
+
+TRACE_MAGIC = 0x54524345
+HEADER = struct.Struct("<IIII")  # magic, timestamp_hz, size, head
+EVENT = struct.Struct("<IBBHII")  # timestamp, id, kind, context, arg0, arg1
+
+KIND_PHASE = {0: "i", 1: "B", 2: "E"}
+
+EXCEPTIONS = {0: "thread", 2: "NMI", 3: "HardFault", 4: "MemManage", 5: "BusFault",
+              6: "UsageFault", 11: "SVCall", 14: "PendSV", 15: "SysTick"}
+
+# nRF52840 IRQn
+IRQS = {0: "POWER_CLOCK", 6: "GPIOTE", 7: "SAADC", 8: "TIMER0", 9: "TIMER1", 10: "TIMER2",
+        11: "RTC0", 12: "TEMP", 16: "WDT", 17: "RTC1", 18: "QDEC", 20: "SWI0_EGU0",
+        21: "SWI1_EGU1", 26: "TIMER3", 27: "TIMER4", 28: "PWM0", 36: "RTC2", 38: "FPU"}
+
+DEFAULT_HEADER = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "trace.h")
+
+
+def trace_ids(header_path):
+    with open(header_path) as f:
+        text = f.read()
+    body = re.search(r"typedef enum\s*{([^}]*)}\s*trace_id_t;", text).group(1)
+    return re.findall(r"^\s*TRACE_ID_(\w+)", body, re.MULTILINE)
+
+
+def elf_symbols(elf_path):
+    out = subprocess.run(["arm-none-eabi-nm", "-C", elf_path],
+                         check=True, capture_output=True, text=True).stdout
+    symbols = {}
+    for line in out.splitlines():
+        parts = line.split()
+        if len(parts) == 3 and parts[1] in "tT":
+            # thumb function pointers have bit 0 set
+            symbols[int(parts[0], 16) & ~1] = parts[2]
+    return symbols
+
+
+def context_name(context):
+    if context >= 16:
+        irq = context - 16
+        return IRQS.get(irq, "IRQ %d" % irq)
+    return EXCEPTIONS.get(context, "exception %d" % context)
+
+
+def decode(dump, names, symbols):
+    offset = dump.find(struct.pack("<I", TRACE_MAGIC))
+    while offset >= 0:
+        _, hz, size, head = HEADER.unpack_from(dump, offset)
+        end = offset + HEADER.size + size * EVENT.size
+        if hz and size and (size & (size - 1)) == 0 and end <= len(dump):
+            break
+        offset = dump.find(struct.pack("<I", TRACE_MAGIC), offset + 4)
+    else:
+        sys.exit("no trace buffer in the dump")
+
+    count = min(head, size)
+    events = []
+    threads = set()
+    boot = 0
+    last = None
+    wraps = 0
+
+    for seq in range(head - count, head):
+        timestamp, event_id, kind, context, arg0, arg1 = EVENT.unpack_from(
+            dump, offset + HEADER.size + (seq % size) * EVENT.size)
+        name = names[event_id] if event_id < len(names) else "id %d" % event_id
+
+        if name == "BOOT":
+            boot += 1
+            last = None
+            wraps = 0
+        elif last is not None and timestamp < last and last - timestamp > 1 << 31:
+            wraps += 1
+        last = timestamp
+
+        event = {
+            "name": name,
+            "ph": KIND_PHASE.get(kind, "i"),
+            "ts": ((wraps << 32) + timestamp) * 1e6 / hz,
+            "pid": boot,
+            "tid": context,
+        }
+        if event["ph"] == "i":
+            event["s"] = "t"
+        if event["ph"] != "E":
+            args = {"arg0": "0x%08x" % arg0, "arg1": "0x%08x" % arg1}
+            if name == "BOTTOM_HALF" and symbols:
+                args["arg0"] = symbols.get(arg0 & ~1, args["arg0"])
+            event["args"] = args
+        events.append(event)
+        threads.add((boot, context))
+
+    for pid, tid in sorted(threads):
+        events.append({"name": "thread_name", "ph": "M", "pid": pid, "tid": tid,
+                       "args": {"name": context_name(tid)}})
+    for pid in sorted({pid for pid, _ in threads}):
+        events.append({"name": "process_name", "ph": "M", "pid": pid,
+                       "args": {"name": "boot %d" % pid}})
+    return events
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("dump", help="binary RAM dump")
+    parser.add_argument("-o", "--output", help="JSON output, default stdout")
+    parser.add_argument("--header", default=DEFAULT_HEADER, help="trace.h for the event names")
+    parser.add_argument("--elf", help="firmware ELF, to name bottom half functions")
+    args = parser.parse_args()
+
+    with open(args.dump, "rb") as f:
+        dump = f.read()
+
+    symbols = elf_symbols(args.elf) if args.elf else {}
+    trace = {"traceEvents": decode(dump, trace_ids(args.header), symbols),
+             "displayTimeUnit": "ms"}
+
+    if args.output:
+        with open(args.output, "w") as f:
+            json.dump(trace, f, indent=1)
+    else:
+        json.dump(trace, sys.stdout, indent=1)
+
+
+if __name__ == "__main__":
+    main()
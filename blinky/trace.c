@@ -0,0 +1,105 @@
+#include <nrfx.h>
+#include <nrf_atomic.h>
+#include <app_util.h>
+#include "trace.h"
+#include "systime.h"
+#include "edge_capture.h"
+
+#if TRACE_ENABLED
+
+#define TRACE_MAGIC 0x54524345UL // "TRCE"
+#define TRACE_MASK (TRACE_CONFIG_SIZE - 1)
+
+STATIC_ASSERT((TRACE_CONFIG_SIZE & TRACE_MASK) == 0);
+
+// Layout read by tools/trace_decode.py, little endian
+STATIC_ASSERT(sizeof(trace_event_t) == 16);
+
+typedef struct
+{
+    uint32_t magic;
+    uint32_t timestamp_hz;
+    uint32_t size;
+    nrf_atomic_u32_t head; // events ever recorded
+    trace_event_t events[TRACE_CONFIG_SIZE];
+} trace_buffer_t;
+
+// not static, so the debugger can find it by name
+trace_buffer_t trace_buffer __attribute__((section(".noinit")));
+
+#if EDGE_CAPTURE_ENABLED
+// TIMER1 is running anyway; an interrupt that nests between capture and
+// read makes the outer event a few us late
+#define TIMESTAMP_HZ 1000000UL
+#define TRACE_TIMESTAMP() edge_capture_now_us()
+#else
+#define TIMESTAMP_HZ SYSTIME_TICK_HZ
+#define TRACE_TIMESTAMP() ((uint32_t)systime_ticks())
+#endif
+
+void trace_init(void)
+{
+    if (trace_buffer.magic != TRACE_MAGIC ||
+        trace_buffer.timestamp_hz != TIMESTAMP_HZ ||
+        trace_buffer.size != TRACE_CONFIG_SIZE)
+    {
+        trace_buffer.timestamp_hz = TIMESTAMP_HZ;
+        trace_buffer.size = TRACE_CONFIG_SIZE;
+        trace_buffer.head = 0;
+        trace_buffer.magic = TRACE_MAGIC;
+    }
+
+    TRACE_INSTANT(TRACE_ID_BOOT, 0, 0);
+}
+
+void trace_record(trace_kind_t kind, trace_id_t id, uint32_t arg0, uint32_t arg1)
+{
+    uint32_t slot = nrf_atomic_u32_fetch_add(&trace_buffer.head, 1) & TRACE_MASK;
+    trace_event_t *p_event = &trace_buffer.events[slot];
+
+    p_event->timestamp = TRACE_TIMESTAMP();
+    p_event->id = (uint8_t)id;
+    p_event->kind = (uint8_t)kind;
+    p_event->context = (uint16_t)__get_IPSR();
+    p_event->arg0 = arg0;
+    p_event->arg1 = arg1;
+}
+
+uint32_t trace_count(void)
+{
+    uint32_t head = trace_buffer.head;
+
+    return (head < TRACE_CONFIG_SIZE) ? head : TRACE_CONFIG_SIZE;
+}
+
+uint32_t trace_tail_get(trace_event_t *p_events, uint32_t count)
+{
+    uint32_t head = trace_buffer.head;
+    uint32_t available = (head < TRACE_CONFIG_SIZE) ? head : TRACE_CONFIG_SIZE;
+
+    if (count > available)
+        count = available;
+
+    for (uint32_t i = 0; i < count; i++)
+        p_events[i] = trace_buffer.events[(head - count + i) & TRACE_MASK];
+
+    return count;
+}
+
+#else
+
+void trace_init(void)
+{
+}
+
+uint32_t trace_count(void)
+{
+    return 0;
+}
+
+uint32_t trace_tail_get(trace_event_t *p_events, uint32_t count)
+{
+    return 0;
+}
+
+#endif // TRACE_ENABLED
@@ -0,0 +1,83 @@
+#ifndef TRACE_H__
+#define TRACE_H__
+
+#include <stdint.h>
+#include <sdk_config.h>
+
+// Binary event trace for ISR / main loop interleaving.
+//
+// An event is a timestamp, an id, the active exception number (0 in
+// thread mode) and two words, 16 bytes written in a few dozen cycles with
+// no formatting. Events go into a ring in .noinit RAM, so the trace of a
+// crashed or reset run is still there. Read the trace_buffer symbol out
+// with a debugger and turn it into Chrome trace JSON (chrome://tracing,
+// Perfetto) with tools/trace_decode.py.
+// With TRACE_ENABLED set to 0 the macros compile to nothing.
+
+// The decoder takes the names from this enum, keep it one id per line
+typedef enum
+{
+    TRACE_ID_BOOT,
+    TRACE_ID_IDLE,        // tickless sleep; arg0: planned wakeup tick (low word)
+    TRACE_ID_BOTTOM_HALF, // one bottom half item; arg0: function, arg1: arg0 of the item
+    TRACE_ID_BUTTON,      // button top half; arg0: pin, arg1: level
+    TRACE_ID_FRAME,       // frame clock tick; arg0: frame count
+    TRACE_ID_GESTURE,     // gesture recognized; arg0: gesture_type_t
+    TRACE_ID_COUNT
+} trace_id_t;
+
+typedef enum
+{
+    TRACE_KIND_INSTANT,
+    TRACE_KIND_BEGIN,
+    TRACE_KIND_END
+} trace_kind_t;
+
+typedef struct
+{
+    uint32_t timestamp;
+    uint8_t id;
+    uint8_t kind;
+    uint16_t context; // IPSR: 0 thread mode, 16 + IRQn in an interrupt
+    uint32_t arg0;
+    uint32_t arg1;
+} trace_event_t;
+
+#if TRACE_ENABLED
+
+#define TRACE_INSTANT(id, arg0, arg1) trace_record(TRACE_KIND_INSTANT, (id), (arg0), (arg1))
+#define TRACE_BEGIN(id, arg0, arg1) trace_record(TRACE_KIND_BEGIN, (id), (arg0), (arg1))
+#define TRACE_END(id) trace_record(TRACE_KIND_END, (id), 0, 0)
+
+#else
+
+#define TRACE_INSTANT(id, arg0, arg1) \
+    do                                \
+    {                                 \
+    } while (0)
+#define TRACE_BEGIN(id, arg0, arg1) \
+    do                              \
+    {                               \
+    } while (0)
+#define TRACE_END(id) \
+    do                \
+    {                 \
+    } while (0)
+
+#endif // TRACE_ENABLED
+
+// Keeps a valid trace from before the reset and records TRACE_ID_BOOT.
+// Call once systime (and edge capture, if enabled) is running.
+void trace_init(void);
+
+// Lock-free, safe from any interrupt priority
+void trace_record(trace_kind_t kind, trace_id_t id, uint32_t arg0, uint32_t arg1);
+
+// Events in the ring, at most TRACE_CONFIG_SIZE; 0 with TRACE_ENABLED off
+uint32_t trace_count(void);
+
+// Copies up to count of the newest events, oldest first, and returns how
+// many were copied. Does not lock, meant for fault handlers.
+uint32_t trace_tail_get(trace_event_t *p_events, uint32_t count);
+
+#endif // TRACE_H__
@@ -0,0 +1,95 @@
+#include <nrfx_wdt.h>
+#include <app_error.h>
+#include "watchdog.h"
+#include "systime.h"
+#include "tickless.h"
+#include "bottom_half.h"
+#include "crash.h"
+#include "irq_priority.h"
+
+#if WATCHDOG_ENABLED
+
+STATIC_ASSERT(WATCHDOG_CONFIG_CHECK_MS + WATCHDOG_CONFIG_CHECK_MS / 4 < WATCHDOG_CONFIG_TIMEOUT_MS);
+
+static const uint32_t deadline_ms[WATCHDOG_TASK_COUNT] = {
+    [WATCHDOG_TASK_RENDER] = WATCHDOG_CONFIG_RENDER_DEADLINE_MS,
+    [WATCHDOG_TASK_INPUT] = WATCHDOG_CONFIG_INPUT_DEADLINE_MS};
+
+static volatile uint32_t checkin_ms[WATCHDOG_TASK_COUNT];
+
+static nrfx_wdt_channel_id channel;
+static tickless_timer_t timer;
+
+// Most overdue task, WATCHDOG_TASK_COUNT if all are in time
+static uint32_t overdue_find(uint32_t now, uint32_t *p_late_ms)
+{
+    uint32_t worst = WATCHDOG_TASK_COUNT;
+
+    *p_late_ms = 0;
+    for (uint32_t task = 0; task < WATCHDOG_TASK_COUNT; task++)
+    {
+        uint32_t age = now - checkin_ms[task];
+
+        if (age > deadline_ms[task] && age - deadline_ms[task] > *p_late_ms)
+        {
+            worst = task;
+            *p_late_ms = age - deadline_ms[task];
+        }
+    }
+
+    return worst;
+}
+
+// Bottom half
+static void heartbeat(uint32_t arg0, uint32_t arg1)
+{
+    watchdog_checkin(WATCHDOG_TASK_INPUT);
+}
+
+// Thread mode, from tickless_idle()
+static void timer_handler(void *p_context)
+{
+    uint32_t late_ms;
+
+    if (overdue_find(systime_ms(), &late_ms) == WATCHDOG_TASK_COUNT)
+        nrfx_wdt_channel_feed(channel);
+
+    // answered by the next check, a full queue counts as a miss
+    bottom_half_post(heartbeat, 0, 0);
+    tickless_timer_start(&timer, WATCHDOG_CONFIG_CHECK_MS, WATCHDOG_CONFIG_CHECK_MS / 4);
+}
+
+// WDT timeout interrupt; the reset follows two LFCLK cycles (61 us) later
+static void wdt_handler(void)
+{
+    uint32_t late_ms;
+    uint32_t task = overdue_find(systime_ms(), &late_ms);
+
+    crash_watchdog_capture(task, late_ms);
+}
+
+void watchdog_init(void)
+{
+    nrfx_wdt_config_t config = {
+        .behaviour = NRF_WDT_BEHAVIOUR_RUN_SLEEP,
+        .reload_value = WATCHDOG_CONFIG_TIMEOUT_MS,
+        .interrupt_priority = IRQ_PRIORITY_WATCHDOG};
+    uint32_t now = systime_ms();
+
+    for (uint32_t task = 0; task < WATCHDOG_TASK_COUNT; task++)
+        checkin_ms[task] = now;
+
+    APP_ERROR_CHECK(nrfx_wdt_init(&config, wdt_handler));
+    APP_ERROR_CHECK(nrfx_wdt_channel_alloc(&channel));
+    nrfx_wdt_enable();
+
+    tickless_timer_init(&timer, timer_handler, NULL);
+    timer_handler(NULL);
+}
+
+void watchdog_checkin(watchdog_task_t task)
+{
+    checkin_ms[task] = systime_ms();
+}
+
+#endif // WATCHDOG_ENABLED
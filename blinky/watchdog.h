@@ -0,0 +1,29 @@
+#ifndef WATCHDOG_H__
+#define WATCHDOG_H__
+
+#include <stdint.h>
+
+// Task watchdog on the hardware WDT.
+//
+// Every task must check in within its own deadline. A tickless timer
+// looks at the check-ins every WATCHDOG_CONFIG_CHECK_MS and feeds the WDT
+// only when none is overdue. The same timer posts a heartbeat to the
+// bottom half, which checks in for the input task, so a stuck bottom half
+// or a main loop that stops running both starve the WDT. Just before the
+// WDT resets the chip, its interrupt stores the most overdue task in the
+// crash record (CRASH_WATCHDOG), reported on the next boot.
+
+typedef enum
+{
+    WATCHDOG_TASK_RENDER, // main loop: frames, coroutines, tickless timers
+    WATCHDOG_TASK_INPUT,  // bottom half, through the heartbeat
+    WATCHDOG_TASK_COUNT   // in a crash record: nothing was overdue
+} watchdog_task_t;
+
+// Starts the WDT, which cannot be stopped again until the next reset
+void watchdog_init(void);
+
+// Safe from any interrupt priority
+void watchdog_checkin(watchdog_task_t task);
+
+#endif // WATCHDOG_H__